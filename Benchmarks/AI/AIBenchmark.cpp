@@ -0,0 +1,249 @@
+#include <benchmark/benchmark.h>
+#include "AI/AlphaBetaEngine.h"
+#include "AI/MCTSEngine.h"
+#include "AI/Position.h"
+#include "AI/ProofNumberSolver.h"
+#include "AI/ThreatSpaceSearch.h"
+#include "AI/TranspositionTable.h"
+#include "Grid/Grid.h"
+
+#include <memory>
+#include <utility>
+
+namespace GridWorks
+{
+    // Empty 7x7 board with four in a row to win, the smallest shape where one thread runs out of steam.
+    static Position MakeAnalysisPosition()
+    {
+        Grid grid(7, 7, '.');
+        grid.SetWinLength(4);
+        return Position(grid, {'X', 'O'});
+    }
+
+    // Lazy SMP scaling: time to reach a fixed depth from a cold table, and nodes per second over all threads.
+    static void BM_LazySMPTimeToDepth(benchmark::State &state)
+    {
+        const size_t threadCount = static_cast<size_t>(state.range(0));
+        const unsigned int depth = static_cast<unsigned int>(state.range(1));
+        std::shared_ptr<TranspositionTable> table = std::make_shared<TranspositionTable>(64);
+        AlphaBetaEngine engine(table, threadCount);
+        Position position = MakeAnalysisPosition();
+
+        uint64_t nodes = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            table->Clear();
+            state.ResumeTiming();
+
+            SearchResult result = engine.Search(position, SearchLimits{depth, 0});
+            nodes += result.stats.nodes;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+        state.counters["tt_hit_rate"] = table->GetStats().GetHitRate();
+    }
+
+    static void ThreadArgs(benchmark::internal::Benchmark *benchmark)
+    {
+        for (int threads : {1, 2, 4, 8, 16})
+            benchmark->Args({threads, 6});
+    }
+
+    // Alpha-beta nodes per second on an empty board with five in a row to win; leaves are scored from the line counts
+    // kept by the search, so the rate should hardly drop as the board grows.
+    static void BM_AlphaBetaNodes(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(5);
+        Position position(grid, {'X', 'O'});
+        AlphaBetaEngine engine;
+        engine.SetThreatPrefilter(false);
+
+        uint64_t nodes = 0;
+        for (auto _ : state)
+        {
+            SearchResult result = engine.Search(position, SearchLimits{2, 100000});
+            nodes += result.stats.nodes;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+    }
+
+    // Nodes to reach a fixed depth with the move ordering heuristics against plain row by row order, from a cold table.
+    static void BM_MoveOrderingNodes(benchmark::State &state)
+    {
+        const unsigned char size = static_cast<unsigned char>(state.range(0));
+        const unsigned int depth = static_cast<unsigned int>(state.range(1));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(4);
+        Position position(grid, {'X', 'O'});
+        std::shared_ptr<TranspositionTable> table = std::make_shared<TranspositionTable>(64);
+        AlphaBetaEngine engine(table);
+        engine.SetOrderingHeuristics(state.range(2) != 0);
+
+        uint64_t nodes = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            table->Clear();
+            state.ResumeTiming();
+
+            SearchResult result = engine.Search(position, SearchLimits{depth, 0});
+            nodes += result.stats.nodes;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+    }
+
+    // MCTS throughput on an empty board with five in a row to win (four below 7x7), from a fresh tree.
+    static void BM_MCTSPlayouts(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(size < 7 ? 4 : 5);
+        Position position(grid, {'X', 'O'});
+
+        uint64_t playouts = 0;
+        for (auto _ : state)
+        {
+            MCTSEngine engine;
+            SearchResult result = engine.Search(position, SearchLimits{0, 10000});
+            playouts += result.stats.playouts;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["playouts/s"] = benchmark::Counter(static_cast<double>(playouts), benchmark::Counter::kIsRate);
+    }
+
+    // Parallel MCTS scaling: playouts per second over all threads on an empty 15x15 board, tree or root parallel.
+    static void BM_MCTSThreads(benchmark::State &state)
+    {
+        const size_t threadCount = static_cast<size_t>(state.range(0));
+        Grid grid(15, 15, '.');
+        grid.SetWinLength(5);
+        Position position(grid, {'X', 'O'});
+
+        uint64_t playouts = 0;
+        for (auto _ : state)
+        {
+            MCTSEngine engine;
+            engine.SetThreadCount(threadCount);
+            engine.SetParallelism(static_cast<MCTSParallelism>(state.range(1)));
+            SearchResult result = engine.Search(position, SearchLimits{0, 0, 50.0});
+            playouts += result.stats.playouts;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["playouts/s"] = benchmark::Counter(static_cast<double>(playouts), benchmark::Counter::kIsRate);
+    }
+
+    static void MCTSThreadArgs(benchmark::internal::Benchmark *benchmark)
+    {
+        for (int parallelism : {TreeParallel, RootParallel})
+        {
+            for (int threads : {1, 2, 4, 8, 16})
+                benchmark->Args({threads, parallelism});
+        }
+    }
+
+    // Playing strength at a fixed wall time per move: a parallel engine plays a single threaded one on 7x7 with four
+    // in a row, taking each side in turn. score is the parallel engine's share of the points, 0.5 being even.
+    static void BM_MCTSStrength(benchmark::State &state)
+    {
+        const double millisecondsPerMove = 5.0;
+        double points = 0.0;
+        uint64_t games = 0;
+        for (auto _ : state)
+        {
+            MCTSEngine parallel(MCTSEngine::DEFAULT_MAX_TREE_NODES, MCTSEngine::DEFAULT_EXPLORATION, games + 1);
+            parallel.SetThreadCount(static_cast<size_t>(state.range(0)));
+            parallel.SetParallelism(static_cast<MCTSParallelism>(state.range(1)));
+            MCTSEngine single(MCTSEngine::DEFAULT_MAX_TREE_NODES, MCTSEngine::DEFAULT_EXPLORATION, games + 1001);
+            MCTSEngine *engines[2] = {&parallel, &single};
+            const size_t parallelSide = games % 2;
+            if (parallelSide == 1)
+                std::swap(engines[0], engines[1]);
+
+            Position position = MakeAnalysisPosition();
+            bool won = false;
+            while (!won && !position.IsFull())
+            {
+                SearchResult result = engines[position.GetSideToMove()]->Search(position, SearchLimits{0, 0, millisecondsPerMove});
+                position.MakeMove(result.bestMove);
+                won = position.IsLastMoveWin();
+            }
+
+            // After a win the side to move is the loser.
+            if (!won)
+                points += 0.5;
+            else if (position.GetSideToMove() != parallelSide)
+                points += 1.0;
+            ++games;
+        }
+
+        state.counters["score"] = games > 0 ? points / games : 0.0;
+    }
+
+    // Time to solve an empty board with df-pn from an empty table; arguments are the board size and win length.
+    static void BM_ProofNumberSolve(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(static_cast<unsigned char>(state.range(1)));
+        Position position(grid, {'X', 'O'});
+        ProofNumberSolver solver;
+
+        uint64_t nodes = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            solver.Clear();
+            state.ResumeTiming();
+
+            ProofResult result = solver.Solve(position);
+            nodes += result.stats.nodes;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+    }
+
+    // Threat-space search for a two-four win on a k=5 board of the given size, mode by argument.
+    static void BM_ThreatSearch(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(5);
+        for (auto [row, col] : {std::pair{3, 10}, {4, 10}, {5, 10}, {6, 7}, {6, 8}})
+            grid.SetCharAt(row, col, 'X');
+        for (auto [row, col] : {std::pair{2, 10}, {9, 9}, {10, 3}, {12, 12}})
+            grid.SetCharAt(row, col, 'O');
+        Position position(grid, {'X', 'O'});
+        ThreatSpaceSearch search(static_cast<ThreatSearchMode>(state.range(1)));
+
+        uint64_t nodes = 0;
+        for (auto _ : state)
+        {
+            ThreatResult result = search.Search(position);
+            nodes += result.stats.nodes;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+    }
+
+    BENCHMARK(BM_LazySMPTimeToDepth)->Apply(ThreadArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_AlphaBetaNodes)->Arg(15)->Arg(64)->Arg(255)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_MoveOrderingNodes)->ArgsProduct({{5, 7}, {5}, {0, 1}})->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_MCTSPlayouts)->Arg(5)->Arg(7)->Arg(15)->Arg(19)->Arg(64)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_MCTSThreads)->Apply(MCTSThreadArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ProofNumberSolve)->Args({3, 3})->Args({4, 3})->Args({4, 4})->Args({5, 4})->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_ThreatSearch)->Args({15, FoursOnly})->Args({15, FoursAndThrees})->Args({64, FoursOnly})->Args({64, FoursAndThrees})->Unit(benchmark::kMicrosecond);
+    BENCHMARK(BM_MCTSStrength)->Args({4, TreeParallel})->Args({4, RootParallel})->Iterations(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
\ No newline at end of file
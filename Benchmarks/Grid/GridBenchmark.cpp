@@ -0,0 +1,252 @@
+#include <benchmark/benchmark.h>
+#include "Grid/Grid.h"
+#include "Grid/FixedGrid.h"
+#include "Grid/GridPool.h"
+#include "Grid/RunKernels.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+// Counts every heap allocation in the benchmark binary, for the allocations per clone counters.
+static std::atomic<size_t> s_AllocationCount = 0;
+
+void *operator new(size_t size)
+{
+    s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace GridWorks
+{
+    // Fills the grid with a pattern that never has three in a row, so every win check has to look at the whole board.
+    static void FillWithoutRuns(Grid &grid)
+    {
+        for (unsigned char row = 0; row < grid.GetRows(); ++row)
+        {
+            for (unsigned char col = 0; col < grid.GetCols(); ++col)
+            {
+                grid.SetCharAt(row, col, (col + 2 * row) % 4 < 2 ? 'X' : 'O');
+            }
+        }
+    }
+
+    // Win checks per second using the nested loops over the cells.
+    static void BM_ScanWinCheck(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+
+        for (auto _ : state)
+        {
+            bool won = grid.CheckForRecurringCharsInRow('X') || grid.CheckForRecurringCharsInCol('X') ||
+                       grid.CheckForRecurringCharsInDiagonal('X') || grid.CheckForRecurringCharsInAntiDiagonal('X');
+            benchmark::DoNotOptimize(won);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(grid.GetGridInfo());
+    }
+
+    // Win checks per second using the shift-and bitsets.
+    static void BM_BitBoardWinCheck(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+
+        for (auto _ : state)
+        {
+            bool won = grid.GetBitBoard().HasRun('X', 3);
+            benchmark::DoNotOptimize(won);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(grid.GetBitBoard().IsSingleWord() ? "single word" : "multi word");
+    }
+
+    // Checks every row and column for a run of k with the vectorized or the scalar kernels.
+    template <bool Vectorized>
+    static void BM_RowColumnRunScan(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        unsigned char runLength = static_cast<unsigned char>(state.range(1));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+        GridView view = grid.GetGrid();
+
+        for (auto _ : state)
+        {
+            bool won = false;
+            for (unsigned char row = 0; row < view.rows && !won; ++row)
+            {
+                won = Vectorized ? RunKernels::HasRowRun(view[row], view.cols, 'X', runLength)
+                                 : RunKernels::HasRowRunScalar(view[row], view.cols, 'X', runLength);
+            }
+            won = won || (Vectorized ? RunKernels::HasColumnRun(view.data, view.rows, view.cols, view.stride, 'X', runLength)
+                                     : RunKernels::HasColumnRunScalar(view.data, view.rows, view.cols, view.stride, 'X', runLength));
+            benchmark::DoNotOptimize(won);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * 2 * grid.GetCellCount());
+        state.SetLabel(Vectorized ? RunKernels::GetInstructionSet() : "Scalar");
+    }
+
+    // Full board win checks with a configurable win length.
+    static void BM_WinLengthScanWinCheck(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        grid.SetWinLength(static_cast<unsigned char>(state.range(1)));
+        FillWithoutRuns(grid);
+
+        for (auto _ : state)
+        {
+            bool won = grid.CheckForRecurringCharsInRow('X') || grid.CheckForRecurringCharsInCol('X') ||
+                       grid.CheckForRecurringCharsInDiagonal('X') || grid.CheckForRecurringCharsInAntiDiagonal('X');
+            benchmark::DoNotOptimize(won);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Random half-filled grids of the given shape, so the win checks see a mix of wins and non-wins.
+    static std::vector<Grid> MakeRandomGrids(unsigned char rows, unsigned char cols, unsigned char winLength)
+    {
+        std::mt19937 rng(42);
+        std::vector<Grid> grids;
+        for (int i = 0; i < 256; ++i)
+        {
+            Grid grid(rows, cols, '.');
+            grid.SetWinLength(winLength);
+            for (unsigned char row = 0; row < rows; ++row)
+                for (unsigned char col = 0; col < cols; ++col)
+                    grid.SetCharAt(row, col, "..XO"[rng() % 4]);
+            grids.push_back(grid);
+        }
+        return grids;
+    }
+
+    // Win and draw check with the runtime sized Grid.
+    template <typename Fixed>
+    static void BM_DynamicWinDrawCheck(benchmark::State &state)
+    {
+        std::vector<Grid> grids = MakeRandomGrids(Fixed::ROWS, Fixed::COLS, Fixed::WIN_LENGTH);
+        size_t index = 0;
+        for (auto _ : state)
+        {
+            const Grid &grid = grids[index++ & 255];
+            bool over = grid.GetBitBoard().HasRun('X', grid.GetWinLength()) || grid.GetBitBoard().HasRun('O', grid.GetWinLength()) || grid.IsFull();
+            benchmark::DoNotOptimize(over);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Same check on the same bitsets with the compile-time win lines of FixedGrid.
+    template <typename Fixed>
+    static void BM_FixedWinDrawCheck(benchmark::State &state)
+    {
+        std::vector<Grid> grids = MakeRandomGrids(Fixed::ROWS, Fixed::COLS, Fixed::WIN_LENGTH);
+        size_t index = 0;
+        for (auto _ : state)
+        {
+            const Grid &grid = grids[index++ & 255];
+            uint64_t x = *grid.GetBitBoard().GetWords('X');
+            uint64_t o = *grid.GetBitBoard().GetWords('O');
+            bool over = Fixed::HasRun(x) || Fixed::HasRun(o) || Fixed::IsFull(x | o);
+            benchmark::DoNotOptimize(over);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Reports clones per second and heap allocations per clone.
+    template <typename Clone>
+    static void RunCloneBenchmark(benchmark::State &state, Clone clone)
+    {
+        size_t allocations = 0;
+        for (auto _ : state)
+        {
+            size_t before = s_AllocationCount.load(std::memory_order_relaxed);
+            clone();
+            allocations += s_AllocationCount.load(std::memory_order_relaxed) - before;
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["allocs/clone"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    }
+
+    // Fresh copy constructed grid for every clone.
+    static void BM_GridCopyConstruct(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+
+        RunCloneBenchmark(state, [&]()
+                          {
+                              Grid copy(grid);
+                              benchmark::DoNotOptimize(copy.GetHash()); });
+    }
+
+    // Copy assignment into a grid that already has the right size.
+    static void BM_GridCopyAssign(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+        Grid copy(size, size, '.');
+
+        RunCloneBenchmark(state, [&]()
+                          {
+                              copy = grid;
+                              benchmark::DoNotOptimize(copy.GetHash()); });
+    }
+
+    // Snapshot from a pool, released again at the end of every clone.
+    static void BM_GridPoolSnapshot(benchmark::State &state)
+    {
+        unsigned char size = static_cast<unsigned char>(state.range(0));
+        Grid grid(size, size, '.');
+        FillWithoutRuns(grid);
+        GridPool pool(size, size, 4);
+
+        RunCloneBenchmark(state, [&]()
+                          {
+                              GridSnapshot snapshot = pool.Acquire(grid);
+                              benchmark::DoNotOptimize(snapshot->GetHash()); });
+    }
+
+    static void WinLengthArgs(benchmark::internal::Benchmark *benchmark)
+    {
+        for (int size : {15, 19, 64, 255})
+            for (int runLength : {3, 5, 6})
+                benchmark->Args({size, runLength});
+    }
+
+    BENCHMARK(BM_ScanWinCheck)->Arg(3)->Arg(8)->Arg(16);
+    BENCHMARK(BM_BitBoardWinCheck)->Arg(3)->Arg(8)->Arg(16);
+
+    BENCHMARK_TEMPLATE(BM_RowColumnRunScan, true)->Apply(WinLengthArgs);
+    BENCHMARK_TEMPLATE(BM_RowColumnRunScan, false)->Apply(WinLengthArgs);
+    BENCHMARK(BM_WinLengthScanWinCheck)->Apply(WinLengthArgs);
+
+    BENCHMARK_TEMPLATE(BM_DynamicWinDrawCheck, FixedGrid3x3);
+    BENCHMARK_TEMPLATE(BM_FixedWinDrawCheck, FixedGrid3x3);
+    BENCHMARK_TEMPLATE(BM_DynamicWinDrawCheck, FixedGrid4x4);
+    BENCHMARK_TEMPLATE(BM_FixedWinDrawCheck, FixedGrid4x4);
+
+    BENCHMARK(BM_GridCopyConstruct)->Arg(3)->Arg(15)->Arg(64);
+    BENCHMARK(BM_GridCopyAssign)->Arg(3)->Arg(15)->Arg(64);
+    BENCHMARK(BM_GridPoolSnapshot)->Arg(3)->Arg(15)->Arg(64);
+}
\ No newline at end of file
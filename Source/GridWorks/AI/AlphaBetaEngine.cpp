@@ -0,0 +1,356 @@
+#include "AlphaBetaEngine.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include <durlib.h>
+
+namespace GridWorks
+{
+    // Win scores count plies from the root; the table stores them counted from the position itself so they stay
+    // valid wherever the position is reached again.
+    static int ScoreToTable(int score, unsigned int ply)
+    {
+        if (score >= WIN_THRESHOLD)
+            return score + static_cast<int>(ply);
+        if (score <= -WIN_THRESHOLD)
+            return score - static_cast<int>(ply);
+        return score;
+    }
+
+    static int ScoreFromTable(int score, unsigned int ply)
+    {
+        if (score >= WIN_THRESHOLD)
+            return score - static_cast<int>(ply);
+        if (score <= -WIN_THRESHOLD)
+            return score + static_cast<int>(ply);
+        return score;
+    }
+
+    // Constructors & Destructors
+    AlphaBetaEngine::AlphaBetaEngine(std::shared_ptr<TranspositionTable> table, size_t threadCount)
+        : m_Table(std::move(table)), m_ThreadCount(std::max<size_t>(threadCount, 1))
+    {
+    }
+
+    // Getters & Setters
+
+    const std::shared_ptr<TranspositionTable> &AlphaBetaEngine::GetTranspositionTable() const
+    {
+        return m_Table;
+    }
+
+    void AlphaBetaEngine::SetTranspositionTable(std::shared_ptr<TranspositionTable> table)
+    {
+        m_Table = std::move(table);
+    }
+
+    size_t AlphaBetaEngine::GetThreadCount() const
+    {
+        return m_ThreadCount;
+    }
+
+    void AlphaBetaEngine::SetThreadCount(size_t threadCount)
+    {
+        m_ThreadCount = std::max<size_t>(threadCount, 1);
+    }
+
+    bool AlphaBetaEngine::GetThreatPrefilter() const
+    {
+        return m_ThreatPrefilter;
+    }
+
+    void AlphaBetaEngine::SetThreatPrefilter(bool enabled)
+    {
+        m_ThreatPrefilter = enabled;
+    }
+
+    bool AlphaBetaEngine::GetOrderingHeuristics() const
+    {
+        return m_OrderingHeuristics;
+    }
+
+    void AlphaBetaEngine::SetOrderingHeuristics(bool enabled)
+    {
+        m_OrderingHeuristics = enabled;
+    }
+
+    // Public methods
+
+    std::string AlphaBetaEngine::GetName() const
+    {
+        return "AlphaBeta";
+    }
+
+    SearchResult AlphaBetaEngine::Search(Position &position, const SearchLimits &limits)
+    {
+        if (position.GetPlayerCount() != 2)
+        {
+            throw std::invalid_argument("AlphaBetaEngine only supports two players");
+        }
+
+        const size_t threadCount = m_Table ? m_ThreadCount : 1;
+        m_Limits = limits;
+        m_ThreadNodeLimit = limits.maxNodes == 0 ? 0 : std::max<uint64_t>(limits.maxNodes / threadCount, 1);
+        m_StopHelpers = false;
+        m_StartTime = std::chrono::steady_clock::now();
+        if (m_Table)
+            m_Table->NewSearch();
+
+        const Grid &grid = position.GetGrid();
+        if (m_ThreatPrefilter && grid.GetWinLength() >= THREAT_PREFILTER_WIN_LENGTH)
+        {
+            // Fours only: every reply is forced, so what it finds is a proven win.
+            SearchLimits threatLimits = {0, THREAT_PREFILTER_NODES, limits.maxMilliseconds / 4.0, limits.stop};
+            ThreatResult threat = m_ThreatSearch.Search(position, threatLimits);
+            if (threat.found)
+            {
+                SearchResult result;
+                result.bestMove = threat.sequence.front();
+                result.score = WIN_SCORE - static_cast<int>(threat.sequence.size());
+                result.stats.nodes = threat.stats.nodes;
+                result.stats.depth = static_cast<unsigned int>(threat.sequence.size());
+                result.stats.elapsedMilliseconds = GetElapsedMilliseconds();
+                return result;
+            }
+        }
+
+        unsigned int emptyCells = static_cast<unsigned int>(grid.GetCellCount() - grid.GetOccupiedCount());
+        unsigned int maxDepth = limits.maxDepth == 0 ? emptyCells : std::min(limits.maxDepth, emptyCells);
+
+        std::vector<SearchThread> threads(threadCount);
+        threads[0].lines.Reset(position);
+        threads[0].ordering.Reset(grid, m_OrderingHeuristics);
+        std::vector<std::thread> helpers;
+        for (size_t id = 1; id < threadCount; ++id)
+        {
+            threads[id].id = id;
+            helpers.emplace_back(&AlphaBetaEngine::RunHelper, this, std::ref(threads[id]), position, maxDepth);
+        }
+
+        // Iterative deepening: every depth reuses the table entries and root order of the one before, so the
+        // repeated shallow work is cheap, and a budget running out still leaves the last completed answer.
+        SearchResult result;
+        SearchThread &main = threads[0];
+        for (unsigned int depth = 1; depth <= maxDepth; ++depth)
+        {
+            Move bestMove = {TranspositionTable::NO_MOVE, TranspositionTable::NO_MOVE};
+            int score = 0;
+            bool completed = SearchRoot(main, position, depth, bestMove, score);
+            // Moves from an unfinished depth are only taken when no depth finished at all.
+            if (completed || depth == 1)
+            {
+                result.bestMove = bestMove;
+                result.score = score;
+            }
+            if (!completed)
+                break;
+
+            result.stats.depth = depth;
+            // A forced result does not change with more depth.
+            if (std::abs(score) >= WIN_THRESHOLD)
+                break;
+            // The next depth costs more than all the ones before it, so it would not finish in the time left.
+            if (limits.maxMilliseconds > 0.0 && GetElapsedMilliseconds() * 2.0 > limits.maxMilliseconds)
+                break;
+        }
+
+        m_StopHelpers = true;
+        for (std::thread &helper : helpers)
+            helper.join();
+        for (const SearchThread &thread : threads)
+            result.stats.nodes += thread.nodes;
+        result.stats.elapsedMilliseconds = GetElapsedMilliseconds();
+        return result;
+    }
+
+    int AlphaBetaEngine::Evaluate(const Position &position)
+    {
+        LineCounts lines;
+        lines.Reset(position);
+        return Evaluate(lines, position.GetSideToMove());
+    }
+
+    int AlphaBetaEngine::Evaluate(const LineCounts &lines, size_t side)
+    {
+        // Lines holding marks of only one side are still open for that side; longer ones weigh exponentially more.
+        // The pattern table carries the same weights and the counts keep their sum.
+        if (lines.HasPatterns())
+        {
+            const int64_t score = side == 0 ? lines.GetPatternScore() : -lines.GetPatternScore();
+            return static_cast<int>(std::clamp<int64_t>(score, -WIN_THRESHOLD / 2, WIN_THRESHOLD / 2));
+        }
+
+        const size_t winLength = lines.GetLines().GetWinLength();
+        int64_t score = 0;
+        for (size_t stones = 1; stones <= winLength; ++stones)
+        {
+            const int64_t weight = 1LL << std::min(3 * static_cast<int>(stones), 30);
+            score += weight * (static_cast<int64_t>(lines.GetOpenLineCount(side, stones)) - lines.GetOpenLineCount(side ^ 1, stones));
+        }
+        return static_cast<int>(std::clamp<int64_t>(score, -WIN_THRESHOLD / 2, WIN_THRESHOLD / 2));
+    }
+
+    // Private methods
+
+    bool AlphaBetaEngine::SearchRoot(SearchThread &thread, Position &position, unsigned int depth, Move &bestMove, int &score)
+    {
+        int alpha = -WIN_SCORE - 1;
+        const int beta = WIN_SCORE + 1;
+        const Move tableMove = m_OrderingHeuristics ? ProbeMove(position) : MoveOrdering::NO_MOVE;
+        // Helpers start the base order at different points so they fill the table with different subtrees.
+        const std::vector<Move> &moveOrder = thread.ordering.GetBaseOrder();
+        const size_t count = moveOrder.size();
+        const size_t offset = thread.id * count / m_ThreadCount;
+        for (size_t i = 0; i <= count; ++i)
+        {
+            // The stored best move, from the last depth, goes first.
+            Move move = i == 0 ? tableMove : moveOrder[(i - 1 + offset) % count];
+            if ((i > 0 && move == tableMove) || !position.IsLegalMove(move.row, move.col))
+                continue;
+            // Always have a legal move to fall back on, even if the budget runs out on the first one.
+            if (bestMove.row == TranspositionTable::NO_MOVE)
+                bestMove = move;
+
+            Play(thread, position, move);
+            int moveScore = -Negamax(thread, position, depth - 1, -beta, -alpha, 1);
+            Undo(thread, position);
+            if (thread.aborted)
+                return false;
+
+            if (moveScore > alpha)
+            {
+                alpha = moveScore;
+                bestMove = move;
+                score = moveScore;
+            }
+        }
+        DEBUG_ASSERT(bestMove.row != TranspositionTable::NO_MOVE, "AlphaBetaEngine searched a position without legal moves.");
+
+        if (m_Table)
+            m_Table->Store(TranspositionTable::GetKey(position), {ScoreToTable(score, 0), static_cast<unsigned char>(std::min(depth, 254u)), ExactBound, bestMove});
+        return true;
+    }
+
+    int AlphaBetaEngine::Negamax(SearchThread &thread, Position &position, unsigned int depth, int alpha, int beta, unsigned int ply)
+    {
+        // Checked on every node, leaves included, so a budget or stop is noticed within one node.
+        if (IsOutOfBudget(thread))
+        {
+            thread.aborted = true;
+            return 0;
+        }
+        ++thread.nodes;
+
+        // The side that just moved completed a line.
+        if (position.IsLastMoveWin())
+            return -(WIN_SCORE - static_cast<int>(ply));
+        if (position.IsFull())
+            return 0;
+        if (depth == 0)
+            return Evaluate(thread.lines, position.GetSideToMove());
+
+        const int originalAlpha = alpha;
+        Move tableMove = {TranspositionTable::NO_MOVE, TranspositionTable::NO_MOVE};
+        const uint64_t key = m_Table ? TranspositionTable::GetKey(position) : 0;
+        TranspositionEntry entry;
+        if (m_Table && m_Table->Probe(key, entry))
+        {
+            tableMove = entry.move;
+            if (entry.depth >= depth)
+            {
+                int score = ScoreFromTable(entry.score, ply);
+                if (entry.bound == ExactBound ||
+                    (entry.bound == LowerBound && score >= beta) ||
+                    (entry.bound == UpperBound && score <= alpha))
+                    return score;
+            }
+        }
+
+        int best = -WIN_SCORE - 1;
+        Move bestMove = tableMove;
+        Move move;
+        thread.ordering.Begin(position, ply, tableMove);
+        while (thread.ordering.Next(position, ply, move))
+        {
+            Play(thread, position, move);
+            int score = -Negamax(thread, position, depth - 1, -beta, -alpha, ply + 1);
+            Undo(thread, position);
+            if (thread.aborted)
+                return 0;
+
+            if (score > best)
+            {
+                best = score;
+                bestMove = move;
+            }
+            if (score > alpha)
+                alpha = score;
+            if (alpha >= beta)
+            {
+                thread.ordering.RecordCutoff(position.GetSideToMove(), move, ply, depth);
+                break;
+            }
+        }
+
+        if (m_Table)
+        {
+            BoundType bound = best <= originalAlpha ? UpperBound : best >= beta ? LowerBound : ExactBound;
+            m_Table->Store(key, {ScoreToTable(best, ply), static_cast<unsigned char>(std::min(depth, 254u)), bound, bestMove});
+        }
+        return best;
+    }
+
+    void AlphaBetaEngine::RunHelper(SearchThread &thread, Position position, unsigned int maxDepth)
+    {
+        thread.lines.Reset(position);
+        thread.ordering.Reset(position.GetGrid(), m_OrderingHeuristics);
+        // Odd helpers run a ply ahead of the main thread, so deeper entries reach the table sooner.
+        for (unsigned int depth = 1 + thread.id % 2; depth <= maxDepth; ++depth)
+        {
+            Move bestMove = {TranspositionTable::NO_MOVE, TranspositionTable::NO_MOVE};
+            int score = 0;
+            if (!SearchRoot(thread, position, depth, bestMove, score) || std::abs(score) >= WIN_THRESHOLD)
+                break;
+        }
+    }
+
+    void AlphaBetaEngine::Play(SearchThread &thread, Position &position, Move move)
+    {
+        thread.lines.Add(position.GetSideToMove(), move);
+        position.MakeMove(move);
+    }
+
+    void AlphaBetaEngine::Undo(SearchThread &thread, Position &position)
+    {
+        const Move move = position.GetLastMove();
+        position.UnmakeMove();
+        thread.lines.Remove(position.GetSideToMove(), move);
+    }
+
+    Move AlphaBetaEngine::ProbeMove(Position &position)
+    {
+        TranspositionEntry entry;
+        if (m_Table && m_Table->Probe(TranspositionTable::GetKey(position), entry))
+            return entry.move;
+        return {TranspositionTable::NO_MOVE, TranspositionTable::NO_MOVE};
+    }
+
+    bool AlphaBetaEngine::IsOutOfBudget(const SearchThread &thread) const
+    {
+        if (m_ThreadNodeLimit != 0 && thread.nodes >= m_ThreadNodeLimit)
+            return true;
+        if (m_StopHelpers.load(std::memory_order_relaxed))
+            return true;
+        if (m_Limits.stop != nullptr && m_Limits.stop->load(std::memory_order_relaxed))
+            return true;
+        return m_Limits.maxMilliseconds > 0.0 && GetElapsedMilliseconds() >= m_Limits.maxMilliseconds;
+    }
+
+    double AlphaBetaEngine::GetElapsedMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime).count();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "AI/Engine.h"
+#include "AI/LineCounts.h"
+#include "AI/MoveOrdering.h"
+#include "AI/ThreatSpaceSearch.h"
+#include "AI/TranspositionTable.h"
+
+namespace GridWorks
+{
+    // Iterative deepening negamax search with alpha-beta pruning.
+    // Moves are ordered by MoveOrdering: the stored best move, killer moves and history first, the rest center first.
+    // Positions at the depth limit are scored by counting the win lines each side can still complete. Every thread
+    // keeps the stone counts of each line up to date as it makes and takes back moves, so a leaf is scored without
+    // looking at the grid: from the running sum of the line pattern scores, or from the open lines per stone count
+    // when the win is too long for a pattern table.
+    // With a transposition table, positions reached again through another move order reuse their stored result.
+    // With more than one thread the search is Lazy SMP: helper threads search the same root on their own copy of the
+    // position, odd ones a ply deeper and each with its root moves rotated, and only talk to the main thread through
+    // the shared table. The main thread's result is the one returned.
+    // On boards with five or more in a row to win, a threat-space search for a win by fours runs first; a win it
+    // finds is played without the full search.
+    class AlphaBetaEngine : public Engine
+    {
+    public:
+        static constexpr unsigned char THREAT_PREFILTER_WIN_LENGTH = 5;
+        // Node budget of the threat search; on large boards it answers in a few thousand.
+        static constexpr uint64_t THREAT_PREFILTER_NODES = 20000;
+
+    private:
+        // Search state owned by one thread; thread 0 is the one that called Search.
+        struct SearchThread
+        {
+            size_t id = 0;
+            uint64_t nodes = 0;
+            bool aborted = false;
+            // Stones on every win line of the thread's position, updated by Play and Undo.
+            LineCounts lines;
+            // Killers and history of the thread's own search.
+            MoveOrdering ordering;
+        };
+
+        // May be shared with other engines; null searches without one.
+        std::shared_ptr<TranspositionTable> m_Table;
+        size_t m_ThreadCount = 1;
+        bool m_ThreatPrefilter = true;
+        bool m_OrderingHeuristics = true;
+        ThreatSpaceSearch m_ThreatSearch{FoursOnly};
+        SearchLimits m_Limits;
+        // maxNodes split evenly over the threads.
+        uint64_t m_ThreadNodeLimit = 0;
+        // Set once the main thread is done, to stop the helpers.
+        std::atomic<bool> m_StopHelpers{false};
+        std::chrono::steady_clock::time_point m_StartTime;
+
+    public:
+        // Constructors & Destructors
+        AlphaBetaEngine() = default;
+        // Threads beyond the first need the table to be of any use; without one the search stays single threaded.
+        explicit AlphaBetaEngine(std::shared_ptr<TranspositionTable> table, size_t threadCount = 1);
+        ~AlphaBetaEngine() override = default;
+
+        // Getters & Setters
+    public:
+        const std::shared_ptr<TranspositionTable> &GetTranspositionTable() const;
+        void SetTranspositionTable(std::shared_ptr<TranspositionTable> table);
+
+        size_t GetThreadCount() const;
+        void SetThreadCount(size_t threadCount);
+
+        bool GetThreatPrefilter() const;
+        void SetThreatPrefilter(bool enabled);
+
+        // Off tries moves row by row with no table move, killers or history; only useful as a baseline.
+        bool GetOrderingHeuristics() const;
+        void SetOrderingHeuristics(bool enabled);
+
+        // Public methods
+    public:
+        std::string GetName() const override;
+        SearchResult Search(Position &position, const SearchLimits &limits) override;
+
+        // Static score of the position for the side to move.
+        static int Evaluate(const Position &position);
+        // Static score for side from line counts kept up to date with the position; the same as Evaluate on it.
+        static int Evaluate(const LineCounts &lines, size_t side);
+
+        // Private methods
+    private:
+        // Searches every root move to depth; returns false if the budget ran out first.
+        bool SearchRoot(SearchThread &thread, Position &position, unsigned int depth, Move &bestMove, int &score);
+        int Negamax(SearchThread &thread, Position &position, unsigned int depth, int alpha, int beta, unsigned int ply);
+        // Iterative deepening loop of a helper thread; runs until the main thread is done.
+        void RunHelper(SearchThread &thread, Position position, unsigned int maxDepth);
+        // MakeMove and UnmakeMove that keep the thread's line counts up to date.
+        void Play(SearchThread &thread, Position &position, Move move);
+        void Undo(SearchThread &thread, Position &position);
+        // Best move stored for the position, or {NO_MOVE, NO_MOVE}.
+        Move ProbeMove(Position &position);
+        bool IsOutOfBudget(const SearchThread &thread) const;
+        double GetElapsedMilliseconds() const;
+    };
+}
\ No newline at end of file
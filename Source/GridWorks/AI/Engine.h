@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "AI/Position.h"
+#include "AI/SearchLimits.h"
+
+namespace GridWorks
+{
+    // Score of a won position; wins found sooner score higher, so a win in n plies is WIN_SCORE - n.
+    constexpr int WIN_SCORE = 1000000;
+    // Scores beyond this are wins or losses rather than evaluations.
+    constexpr int WIN_THRESHOLD = WIN_SCORE - 65536;
+
+    struct SearchStats
+    {
+        // Positions searched; for tree search engines, iterations.
+        uint64_t nodes = 0;
+        // Deepest ply the search completed; for tree search engines, the deepest ply of the tree.
+        unsigned int depth = 0;
+        // Random games played to the end, for engines that play them.
+        uint64_t playouts = 0;
+        double elapsedMilliseconds = 0.0;
+
+        double GetNodesPerSecond() const
+        {
+            return elapsedMilliseconds > 0.0 ? nodes * 1000.0 / elapsedMilliseconds : 0.0;
+        }
+
+        double GetPlayoutsPerSecond() const
+        {
+            return elapsedMilliseconds > 0.0 ? playouts * 1000.0 / elapsedMilliseconds : 0.0;
+        }
+    };
+
+    struct SearchResult
+    {
+        Move bestMove = {0, 0};
+        // From the point of view of the side to move.
+        int score = 0;
+        SearchStats stats;
+    };
+
+    // Picks moves for PlayerType::AI players; see GameLogic::MakeAIMove.
+    class Engine
+    {
+    public:
+        virtual ~Engine() = default;
+
+        virtual std::string GetName() const = 0;
+
+        // Searches position within limits and returns the best move for the side to move.
+        // The position is walked with MakeMove/UnmakeMove and is unchanged when the search returns.
+        virtual SearchResult Search(Position &position, const SearchLimits &limits) = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "LineCounts.h"
+
+namespace GridWorks
+{
+    // Public methods
+
+    void LineCounts::Reset(const Position &position)
+    {
+        const Grid &grid = position.GetGrid();
+        m_Lines = &grid.GetWinLines();
+        m_OpenLines[0] = m_OpenLines[1] = m_Lines->GetLineCount();
+        m_Patterns = PatternTable::Get(m_Lines->GetWinLength());
+        m_Codes.assign(m_Patterns ? m_Lines->GetLineCount() : 0, 0);
+        for (size_t side = 0; side < 2; ++side)
+        {
+            const char playerChar = position.GetPlayerChar(side);
+            std::vector<uint8_t> &counts = m_Counts[side];
+            counts.assign(m_Lines->GetLineCount(), 0);
+            for (size_t line = 0; line < counts.size(); ++line)
+            {
+                std::span<const uint16_t> cells = m_Lines->GetLineCells(line);
+                for (size_t i = 0; i < cells.size(); ++i)
+                {
+                    auto [row, col] = m_Lines->FromCell(cells[i]);
+                    if (grid.GetCharAt(row, col) != playerChar)
+                        continue;
+                    ++counts[line];
+                    if (m_Patterns)
+                        m_Codes[line] = static_cast<uint16_t>(m_Codes[line] + PatternTable::DIGIT_WEIGHTS[i] * (side + 1));
+                }
+                // One stone of side is enough to take the line away from the other.
+                if (counts[line] > 0)
+                    --m_OpenLines[side ^ 1];
+            }
+        }
+
+        for (size_t side = 0; side < 2; ++side)
+        {
+            m_OpenByStones[side].assign(m_Lines->GetWinLength() + 1, 0);
+            for (size_t line = 0; line < m_Counts[side].size(); ++line)
+            {
+                if (m_Counts[side ^ 1][line] == 0)
+                    ++m_OpenByStones[side][m_Counts[side][line]];
+            }
+        }
+
+        m_PatternScore = 0;
+        for (uint16_t code : m_Codes)
+            m_PatternScore += m_Patterns->Lookup(code).score;
+    }
+
+    void LineCounts::Add(size_t side, Move move)
+    {
+        std::vector<uint8_t> &counts = m_Counts[side];
+        const std::vector<uint8_t> &otherCounts = m_Counts[side ^ 1];
+        for (uint32_t line : m_Lines->GetLinesThrough(move.row, move.col))
+        {
+            const uint8_t stones = counts[line]++;
+            if (otherCounts[line] == 0)
+            {
+                --m_OpenByStones[side][stones];
+                ++m_OpenByStones[side][stones + 1];
+            }
+            if (stones == 0)
+            {
+                --m_OpenLines[side ^ 1];
+                --m_OpenByStones[side ^ 1][otherCounts[line]];
+            }
+        }
+        if (m_Patterns)
+            UpdateCodes(side, move, 1);
+    }
+
+    void LineCounts::Remove(size_t side, Move move)
+    {
+        std::vector<uint8_t> &counts = m_Counts[side];
+        const std::vector<uint8_t> &otherCounts = m_Counts[side ^ 1];
+        for (uint32_t line : m_Lines->GetLinesThrough(move.row, move.col))
+        {
+            const uint8_t stones = --counts[line];
+            if (otherCounts[line] == 0)
+            {
+                --m_OpenByStones[side][stones + 1];
+                ++m_OpenByStones[side][stones];
+            }
+            if (stones == 0)
+            {
+                ++m_OpenLines[side ^ 1];
+                ++m_OpenByStones[side ^ 1][otherCounts[line]];
+            }
+        }
+        if (m_Patterns)
+            UpdateCodes(side, move, -1);
+    }
+
+    // Private methods
+
+    void LineCounts::UpdateCodes(size_t side, Move move, int sign)
+    {
+        std::span<const uint32_t> lines = m_Lines->GetLinesThrough(move.row, move.col);
+        std::span<const uint8_t> positions = m_Lines->GetLinePositionsThrough(move.row, move.col);
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            uint16_t &code = m_Codes[lines[i]];
+            m_PatternScore -= m_Patterns->Lookup(code).score;
+            code = static_cast<uint16_t>(code + sign * PatternTable::DIGIT_WEIGHTS[positions[i]] * static_cast<int>(side + 1));
+            m_PatternScore += m_Patterns->Lookup(code).score;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AI/PatternTable.h"
+#include "AI/Position.h"
+#include "Grid/WinLineTable.h"
+
+namespace GridWorks
+{
+    // Stones of both sides on every win line of a two player position, kept up to date move by move in O(lines
+    // through the cell). Counts are one flat array per side indexed by the line's number in the WinLineTable.
+    // A line is open for a side while the other side has no stone on it; open lines are also counted by how many
+    // stones of the side they hold (open twos, open threes, ...), so features of the whole grid read in constant time.
+    // When the win length has a PatternTable, every line also keeps its pattern code, which gives its threat class and
+    // empty cells with one lookup, and the sum of the line scores is kept as well.
+    class LineCounts
+    {
+    private:
+        const WinLineTable *m_Lines = nullptr;
+        std::vector<uint8_t> m_Counts[2];
+        size_t m_OpenLines[2] = {};
+        // m_OpenByStones[side][n] is the number of lines open for side that hold n of its stones.
+        std::vector<uint32_t> m_OpenByStones[2];
+        // Null when the win length is too long for a table.
+        std::shared_ptr<const PatternTable> m_Patterns;
+        std::vector<uint16_t> m_Codes;
+        // Sum of the pattern scores of every line, for side 0.
+        int64_t m_PatternScore = 0;
+
+    public:
+        // Getters & Setters
+    public:
+        // Win lines of the grid given to Reset; the grid's table outlives it.
+        const WinLineTable &GetLines() const { return *m_Lines; }
+        size_t GetLineCount() const { return m_Counts[0].size(); }
+
+        uint8_t GetCount(size_t side, size_t line) const { return m_Counts[side][line]; }
+        size_t GetOpenLineCount(size_t side) const { return m_OpenLines[side]; }
+        // Lines open for side that hold exactly stones of its stones, from 0 to the win length.
+        uint32_t GetOpenLineCount(size_t side, size_t stones) const { return m_OpenByStones[side][stones]; }
+
+        bool HasPatterns() const { return m_Patterns != nullptr; }
+        // Only with HasPatterns.
+        const PatternEntry &GetPattern(size_t line) const { return m_Patterns->Lookup(m_Codes[line]); }
+        int64_t GetPatternScore() const { return m_PatternScore; }
+
+        // Public methods
+    public:
+        // Counts the stones of position from scratch.
+        void Reset(const Position &position);
+
+        // Call with the side and cell of every move made and taken back after Reset.
+        void Add(size_t side, Move move);
+        void Remove(size_t side, Move move);
+
+        // Private methods
+    private:
+        // Adds (sign 1) or takes back (sign -1) a stone of side in the codes of the lines through move.
+        void UpdateCodes(size_t side, Move move, int sign);
+    };
+}
\ No newline at end of file
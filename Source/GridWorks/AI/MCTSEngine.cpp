@@ -0,0 +1,610 @@
+#include "MCTSEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include <durlib.h>
+
+#include "AI/MoveOrdering.h"
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+    MCTSEngine::NodeArena::NodeArena(size_t capacity)
+        : m_Capacity(std::min<size_t>(capacity, NO_NODE)),
+          m_Chunks(std::make_unique<std::atomic<Node *>[]>((m_Capacity + CHUNK_SIZE - 1) / CHUNK_SIZE))
+    {
+    }
+
+    MCTSEngine::MCTSEngine(size_t maxTreeNodes, double exploration, uint64_t seed)
+        : m_MaxTreeNodes(std::max<size_t>(maxTreeNodes, 1)), m_Exploration(exploration), m_Seed(seed)
+    {
+    }
+
+    // Getters & Setters
+
+    size_t MCTSEngine::GetThreadCount() const
+    {
+        return m_ThreadCount;
+    }
+
+    void MCTSEngine::SetThreadCount(size_t threadCount)
+    {
+        m_ThreadCount = std::max<size_t>(threadCount, 1);
+    }
+
+    MCTSParallelism MCTSEngine::GetParallelism() const
+    {
+        return m_Parallelism;
+    }
+
+    void MCTSEngine::SetParallelism(MCTSParallelism parallelism)
+    {
+        m_Parallelism = parallelism;
+    }
+
+    size_t MCTSEngine::GetTreeSize() const
+    {
+        size_t size = 0;
+        for (const std::unique_ptr<Tree> &tree : m_Trees)
+            size += tree->GetNodes().GetSize();
+        return size;
+    }
+
+    uint32_t MCTSEngine::GetRootVisits() const
+    {
+        uint32_t visits = 0;
+        for (const std::unique_ptr<Tree> &tree : m_Trees)
+        {
+            if (tree->root != NO_NODE)
+                visits += tree->GetNodes()[tree->root].visits.load(std::memory_order_relaxed);
+        }
+        return visits;
+    }
+
+    // Public methods
+
+    MCTSEngine::Node &MCTSEngine::NodeArena::operator[](uint32_t index) const
+    {
+        return m_Chunks[index >> CHUNK_SHIFT].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+    }
+
+    size_t MCTSEngine::NodeArena::GetSize() const
+    {
+        return m_Size.load(std::memory_order_relaxed);
+    }
+
+    uint32_t MCTSEngine::NodeArena::Allocate()
+    {
+        // Only grows while there is room, so the size never counts nodes that were not handed out.
+        uint32_t index = m_Size.load(std::memory_order_relaxed);
+        do
+        {
+            if (index >= m_Capacity)
+                return NO_NODE;
+        } while (!m_Size.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+        std::atomic<Node *> &chunk = m_Chunks[index >> CHUNK_SHIFT];
+        Node *nodes = chunk.load(std::memory_order_acquire);
+        if (nodes == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_ChunkMutex);
+            nodes = chunk.load(std::memory_order_acquire);
+            if (nodes == nullptr)
+            {
+                m_Owned.push_back(std::make_unique<Node[]>(CHUNK_SIZE));
+                nodes = m_Owned.back().get();
+                chunk.store(nodes, std::memory_order_release);
+            }
+        }
+
+        // Chunks are reused after Clear, so every field goes back to its default.
+        Node &node = nodes[index & (CHUNK_SIZE - 1)];
+        node.parent = NO_NODE;
+        node.firstChild.store(NO_NODE, std::memory_order_relaxed);
+        node.nextSibling = NO_NODE;
+        node.visits.store(0, std::memory_order_relaxed);
+        node.halfWins.store(0, std::memory_order_relaxed);
+        node.nextMove.store(0, std::memory_order_relaxed);
+        node.cell = 0;
+        node.result = Ongoing;
+        return index;
+    }
+
+    void MCTSEngine::NodeArena::Release(uint32_t index)
+    {
+        uint32_t last = index + 1;
+        m_Size.compare_exchange_strong(last, index, std::memory_order_relaxed);
+    }
+
+    void MCTSEngine::NodeArena::Clear()
+    {
+        m_Size.store(0, std::memory_order_relaxed);
+    }
+
+    std::string MCTSEngine::GetName() const
+    {
+        return "MCTS";
+    }
+
+    SearchResult MCTSEngine::Search(Position &position, const SearchLimits &limits)
+    {
+        if (position.GetPlayerCount() != 2)
+        {
+            throw std::invalid_argument("MCTSEngine only supports two players");
+        }
+
+        m_Limits = limits;
+        m_IterationLimit = limits.maxNodes;
+        if (limits.maxNodes == 0 && limits.maxMilliseconds <= 0.0 && limits.stop == nullptr)
+            m_IterationLimit = DEFAULT_ITERATIONS;
+        m_Iterations.store(0, std::memory_order_relaxed);
+        m_StartTime = std::chrono::steady_clock::now();
+
+        SetShape(position.GetGrid());
+        std::vector<uint8_t> board;
+        BuildBoard(position, board);
+        const size_t side = position.GetSideToMove();
+
+        const size_t treeCount = m_Parallelism == RootParallel ? m_ThreadCount : 1;
+        if (m_Trees.size() != treeCount)
+        {
+            m_Trees.clear();
+            for (size_t index = 0; index < treeCount; ++index)
+            {
+                std::unique_ptr<Tree> tree = std::make_unique<Tree>();
+                tree->arenas[0] = std::make_unique<NodeArena>(m_MaxTreeNodes);
+                tree->arenas[1] = std::make_unique<NodeArena>(m_MaxTreeNodes);
+                m_Trees.push_back(std::move(tree));
+            }
+        }
+        // SetRoot walks from the old root board, so the new one is only stored after.
+        for (std::unique_ptr<Tree> &tree : m_Trees)
+            SetRoot(*tree, board, side);
+
+        m_RootBoard = board;
+        m_RootSide = side;
+        m_RootEmpty.clear();
+        for (uint32_t cell : m_MoveOrder)
+        {
+            if (board[cell] == EMPTY)
+                m_RootEmpty.push_back(cell);
+        }
+        DEBUG_ASSERT(!m_RootEmpty.empty(), "MCTSEngine searched a position without legal moves.");
+
+        std::vector<Worker> workers(m_ThreadCount);
+        for (size_t id = 0; id < workers.size(); ++id)
+        {
+            Worker &worker = workers[id];
+            worker.tree = m_Trees[m_Parallelism == RootParallel ? id : 0].get();
+            worker.board = m_RootBoard;
+            worker.empty = m_RootEmpty;
+            worker.randomState = NextRandom(m_Seed);
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t id = 1; id < workers.size(); ++id)
+            threads.emplace_back(&MCTSEngine::RunWorker, this, std::ref(workers[id]));
+        RunWorker(workers[0]);
+        for (std::thread &thread : threads)
+            thread.join();
+
+        // Root children of every tree, added up by cell. The most visited move is the one the search trusts most;
+        // win rates of rarely visited moves are noise.
+        std::vector<uint64_t> visits(m_RootBoard.size(), 0);
+        std::vector<uint64_t> halfWins(m_RootBoard.size(), 0);
+        for (const std::unique_ptr<Tree> &tree : m_Trees)
+        {
+            const NodeArena &nodes = tree->GetNodes();
+            for (uint32_t child = nodes[tree->root].firstChild.load(std::memory_order_acquire); child != NO_NODE; child = nodes[child].nextSibling)
+            {
+                visits[nodes[child].cell] += nodes[child].visits.load(std::memory_order_relaxed);
+                halfWins[nodes[child].cell] += nodes[child].halfWins.load(std::memory_order_relaxed);
+            }
+        }
+
+        SearchResult result;
+        uint32_t best = NO_NODE;
+        for (uint32_t cell : m_RootEmpty)
+        {
+            if (visits[cell] > 0 && (best == NO_NODE || visits[cell] > visits[best]))
+                best = cell;
+        }
+
+        if (best != NO_NODE)
+        {
+            result.bestMove = ToMove(best);
+            // Win rate mapped to [-1000, 1000].
+            result.score = static_cast<int>(std::lround((static_cast<double>(halfWins[best]) / visits[best] - 1.0) * 1000.0));
+        }
+        else
+        {
+            // Stopped before the first iteration; fall back to the first empty cell, center first.
+            result.bestMove = ToMove(m_RootEmpty.front());
+        }
+
+        for (const Worker &worker : workers)
+        {
+            result.stats.nodes += worker.iterations;
+            result.stats.playouts += worker.playouts;
+            result.stats.depth = std::max(result.stats.depth, worker.depth);
+        }
+        result.stats.elapsedMilliseconds = GetElapsedMilliseconds();
+        return result;
+    }
+
+    void MCTSEngine::Reset()
+    {
+        m_Trees.clear();
+    }
+
+    // Private methods
+
+    void MCTSEngine::SetShape(const Grid &grid)
+    {
+        if (grid.GetRows() == m_Rows && grid.GetCols() == m_Cols && grid.GetWinLength() == m_WinLength)
+            return;
+
+        Reset();
+        m_Rows = grid.GetRows();
+        m_Cols = grid.GetCols();
+        m_WinLength = grid.GetWinLength();
+        m_Stride = static_cast<size_t>(m_Cols) + 2;
+        int stride = static_cast<int>(m_Stride);
+        m_Directions[0] = 1;
+        m_Directions[1] = stride;
+        m_Directions[2] = stride + 1;
+        m_Directions[3] = stride - 1;
+
+        // Children are expanded center first, in the padded board's cell indices.
+        m_MoveOrder.clear();
+        for (const Move &move : *MoveOrdering::GetCenterFirstOrder(grid))
+            m_MoveOrder.push_back(static_cast<uint32_t>((move.row + 1) * m_Stride + move.col + 1));
+    }
+
+    void MCTSEngine::BuildBoard(const Position &position, std::vector<uint8_t> &board) const
+    {
+        const Grid &grid = position.GetGrid();
+        board.assign(m_Stride * (static_cast<size_t>(m_Rows) + 2), WALL);
+        for (unsigned char row = 0; row < m_Rows; ++row)
+        {
+            for (unsigned char col = 0; col < m_Cols; ++col)
+            {
+                char value = grid.GetCharAt(row, col);
+                uint8_t &cell = board[(row + 1) * m_Stride + col + 1];
+                if (value == grid.GetDefaultChar())
+                    cell = EMPTY;
+                else if (value == position.GetPlayerChar(0))
+                    cell = 1;
+                else if (value == position.GetPlayerChar(1))
+                    cell = 2;
+            }
+        }
+    }
+
+    void MCTSEngine::SetRoot(Tree &tree, const std::vector<uint8_t> &board, size_t side) const
+    {
+        NodeArena &nodes = tree.GetNodes();
+
+        // Look for the position up to two plies below the old root: our move and the opponent's reply.
+        uint32_t found = NO_NODE;
+        if (tree.root != NO_NODE)
+        {
+            std::vector<uint8_t> walked = m_RootBoard;
+            uint32_t node = tree.root;
+            size_t walkedSide = m_RootSide;
+            for (unsigned int ply = 0; ply <= 2; ++ply)
+            {
+                if (walkedSide == side && walked == board)
+                {
+                    found = node;
+                    break;
+                }
+
+                uint32_t next = NO_NODE;
+                for (uint32_t child = nodes[node].firstChild.load(std::memory_order_acquire); child != NO_NODE && ply < 2; child = nodes[child].nextSibling)
+                {
+                    uint32_t cell = nodes[child].cell;
+                    if (walked[cell] == EMPTY && board[cell] == walkedSide + 1)
+                    {
+                        next = child;
+                        break;
+                    }
+                }
+                if (next == NO_NODE)
+                    break;
+                walked[nodes[next].cell] = static_cast<uint8_t>(walkedSide + 1);
+                walkedSide ^= 1;
+                node = next;
+            }
+        }
+
+        if (found != NO_NODE && nodes[found].result == Ongoing)
+        {
+            CompactTree(tree, found);
+        }
+        else
+        {
+            nodes.Clear();
+            tree.root = nodes.Allocate();
+        }
+    }
+
+    void MCTSEngine::CompactTree(Tree &tree, uint32_t root) const
+    {
+        NodeArena &from = tree.GetNodes();
+        NodeArena &to = *tree.arenas[1 - tree.current];
+        to.Clear();
+
+        // Copies keep the old firstChild until their own children are copied.
+        auto copy = [&](uint32_t source, uint32_t parent)
+        {
+            uint32_t index = to.Allocate();
+            Node &node = to[index];
+            const Node &original = from[source];
+            node.parent = parent;
+            node.firstChild.store(original.firstChild.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node.visits.store(original.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node.halfWins.store(original.halfWins.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node.nextMove.store(original.nextMove.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node.cell = original.cell;
+            node.result = original.result;
+            return index;
+        };
+
+        // Breadth first, so every node's children end up next to each other in the new arena.
+        copy(root, NO_NODE);
+        for (uint32_t index = 0; index < to.GetSize(); ++index)
+        {
+            uint32_t previous = NO_NODE;
+            uint32_t oldChild = to[index].firstChild.load(std::memory_order_relaxed);
+            to[index].firstChild.store(NO_NODE, std::memory_order_relaxed);
+            for (; oldChild != NO_NODE; oldChild = from[oldChild].nextSibling)
+            {
+                uint32_t child = copy(oldChild, index);
+                if (previous == NO_NODE)
+                    to[index].firstChild.store(child, std::memory_order_relaxed);
+                else
+                    to[previous].nextSibling = child;
+                previous = child;
+            }
+        }
+
+        from.Clear();
+        tree.current = 1 - tree.current;
+        tree.root = 0;
+    }
+
+    void MCTSEngine::RunWorker(Worker &worker)
+    {
+        while (!IsOutOfBudget())
+        {
+            if (m_IterationLimit != 0 && m_Iterations.fetch_add(1, std::memory_order_relaxed) >= m_IterationLimit)
+                break;
+            worker.depth = std::max(worker.depth, RunIteration(worker));
+            ++worker.iterations;
+        }
+    }
+
+    unsigned int MCTSEngine::RunIteration(Worker &worker)
+    {
+        NodeArena &nodes = worker.tree->GetNodes();
+        uint32_t node = worker.tree->root;
+        size_t side = m_RootSide;
+        size_t emptyLeft = m_RootEmpty.size();
+        unsigned int ply = 0;
+
+        // Selection and expansion: walk down fully expanded nodes and stop at the first new child. Every node is
+        // counted as visited on the way down, so other threads see it as a loss until the result is backed up.
+        nodes[node].visits.fetch_add(1, std::memory_order_relaxed);
+        while (nodes[node].result == Ongoing)
+        {
+            uint32_t child = nodes[node].nextMove.load(std::memory_order_relaxed) < m_MoveOrder.size() ? Expand(worker, node, emptyLeft, side) : NO_NODE;
+            bool expanded = child != NO_NODE;
+            if (!expanded)
+            {
+                // A full arena, or a move claimed by another thread and not linked yet, can leave no child to pick;
+                // play out from the node.
+                child = SelectChild(nodes, node);
+                if (child == NO_NODE)
+                    break;
+                nodes[child].visits.fetch_add(1, std::memory_order_relaxed);
+                Place(worker, nodes[child].cell, side);
+            }
+            node = child;
+            side ^= 1;
+            --emptyLeft;
+            ++ply;
+            if (expanded)
+                break;
+        }
+
+        // Simulation.
+        size_t winner;
+        if (nodes[node].result == MoverWon)
+        {
+            winner = side ^ 1;
+        }
+        else if (nodes[node].result == Drawn)
+        {
+            winner = DRAW;
+        }
+        else
+        {
+            winner = Playout(worker, side, emptyLeft);
+            ++worker.playouts;
+        }
+
+        // Backup, every node scored for the player who moved into it; the visits were counted on the way down.
+        size_t mover = side ^ 1;
+        for (uint32_t current = node; current != NO_NODE; current = nodes[current].parent)
+        {
+            uint32_t points = winner == mover ? 2 : winner == DRAW ? 1 : 0;
+            if (points > 0)
+                nodes[current].halfWins.fetch_add(points, std::memory_order_relaxed);
+            mover ^= 1;
+        }
+
+        for (uint32_t cell : worker.placed)
+            worker.board[cell] = EMPTY;
+        worker.placed.clear();
+        return ply;
+    }
+
+    uint32_t MCTSEngine::SelectChild(const NodeArena &nodes, uint32_t node) const
+    {
+        // UCB1: win rate plus an exploration bonus that shrinks as a child gets visited.
+        const double logVisits = std::log(static_cast<double>(std::max<uint32_t>(nodes[node].visits.load(std::memory_order_relaxed), 1)));
+        uint32_t best = NO_NODE;
+        double bestValue = -1.0;
+        for (uint32_t child = nodes[node].firstChild.load(std::memory_order_acquire); child != NO_NODE; child = nodes[child].nextSibling)
+        {
+            const Node &candidate = nodes[child];
+            const double visits = std::max<uint32_t>(candidate.visits.load(std::memory_order_relaxed), 1);
+            double value = candidate.halfWins.load(std::memory_order_relaxed) / (2.0 * visits) + m_Exploration * std::sqrt(logVisits / visits);
+            if (value > bestValue)
+            {
+                best = child;
+                bestValue = value;
+            }
+        }
+        return best;
+    }
+
+    uint32_t MCTSEngine::Expand(Worker &worker, uint32_t node, size_t emptyLeft, size_t side)
+    {
+        NodeArena &nodes = worker.tree->GetNodes();
+        Node &parent = nodes[node];
+        const uint32_t moveCount = static_cast<uint32_t>(m_MoveOrder.size());
+        auto findUntried = [&](uint32_t index)
+        {
+            while (index < moveCount && worker.board[m_MoveOrder[index]] != EMPTY)
+                ++index;
+            return index;
+        };
+
+        // Once no move is left the scan start jumps to the end, so later visits skip it.
+        auto markTried = [&](uint32_t expected)
+        {
+            while (expected < moveCount && !parent.nextMove.compare_exchange_weak(expected, moveCount, std::memory_order_relaxed))
+            {
+            }
+        };
+
+        uint32_t expected = parent.nextMove.load(std::memory_order_relaxed);
+        uint32_t index = findUntried(expected);
+        if (index == moveCount)
+        {
+            markTried(expected);
+            return NO_NODE;
+        }
+
+        // The node is taken before the move is claimed: a claimed move that gets no node would never become a child.
+        uint32_t childIndex = nodes.Allocate();
+        if (childIndex == NO_NODE)
+            return NO_NODE;
+
+        // Claim the next untried move; a thread that loses the race rescans from where the winner left off.
+        while (!parent.nextMove.compare_exchange_weak(expected, index + 1, std::memory_order_relaxed))
+        {
+            index = findUntried(expected);
+            if (index == moveCount)
+            {
+                markTried(expected);
+                nodes.Release(childIndex);
+                return NO_NODE;
+            }
+        }
+
+        Node &child = nodes[childIndex];
+        child.parent = node;
+        child.cell = m_MoveOrder[index];
+        Place(worker, child.cell, side);
+        child.result = IsWinAt(worker.board, child.cell) ? MoverWon : emptyLeft == 1 ? Drawn : Ongoing;
+        // The iteration that adds the child is its first visit.
+        child.visits.store(1, std::memory_order_relaxed);
+
+        // Publish the child at the head of the parent's list; the release makes its fields visible with it.
+        uint32_t head = parent.firstChild.load(std::memory_order_relaxed);
+        do
+        {
+            child.nextSibling = head;
+        } while (!parent.firstChild.compare_exchange_weak(head, childIndex, std::memory_order_release, std::memory_order_relaxed));
+        return childIndex;
+    }
+
+    size_t MCTSEngine::Playout(Worker &worker, size_t side, size_t emptyLeft)
+    {
+        // Every empty cell of the board is in empty[0, count); picks are swapped behind count.
+        std::vector<uint32_t> &empty = worker.empty;
+        size_t count = empty.size();
+        while (emptyLeft > 0)
+        {
+            size_t pick = static_cast<size_t>(((NextRandom(worker.randomState) >> 32) * count) >> 32);
+            uint32_t cell = empty[pick];
+            empty[pick] = empty[--count];
+            empty[count] = cell;
+            // Taken by a move higher up in the tree.
+            if (worker.board[cell] != EMPTY)
+                continue;
+
+            Place(worker, cell, side);
+            --emptyLeft;
+            if (IsWinAt(worker.board, cell))
+                return side;
+            side ^= 1;
+        }
+        return DRAW;
+    }
+
+    void MCTSEngine::Place(Worker &worker, uint32_t cell, size_t side) const
+    {
+        worker.board[cell] = static_cast<uint8_t>(side + 1);
+        worker.placed.push_back(cell);
+    }
+
+    bool MCTSEngine::IsWinAt(const std::vector<uint8_t> &board, uint32_t cell) const
+    {
+        const uint8_t value = board[cell];
+        for (int direction : m_Directions)
+        {
+            unsigned int run = 1;
+            for (uint32_t next = cell + direction; board[next] == value; next += direction)
+                ++run;
+            for (uint32_t next = cell - direction; board[next] == value; next -= direction)
+                ++run;
+            if (run >= m_WinLength)
+                return true;
+        }
+        return false;
+    }
+
+    Move MCTSEngine::ToMove(uint32_t cell) const
+    {
+        return Move{static_cast<unsigned char>(cell / m_Stride - 1), static_cast<unsigned char>(cell % m_Stride - 1)};
+    }
+
+    uint64_t MCTSEngine::NextRandom(uint64_t &state)
+    {
+        // SplitMix64.
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    bool MCTSEngine::IsOutOfBudget() const
+    {
+        if (m_Limits.stop != nullptr && m_Limits.stop->load(std::memory_order_relaxed))
+            return true;
+        return m_Limits.maxMilliseconds > 0.0 && GetElapsedMilliseconds() >= m_Limits.maxMilliseconds;
+    }
+
+    double MCTSEngine::GetElapsedMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime).count();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AI/Engine.h"
+
+namespace GridWorks
+{
+    // How MCTSEngine spreads one search over its threads.
+    enum MCTSParallelism
+    {
+        // Every thread walks the same tree; virtual loss steers them apart.
+        TreeParallel = 0,
+        // Every thread grows its own tree; the root visit counts are added up at the end.
+        RootParallel = 1
+    };
+
+    // Monte Carlo tree search with UCT selection, for boards too large to search exhaustively.
+    // Every iteration walks down the tree by UCB1, adds one child, plays the game out at random and backs the result
+    // up the path. Nodes live in a chunked arena and point at each other by index.
+    // The tree is kept between searches: when the next position is the current root plus our move and the
+    // opponent's reply, that subtree becomes the new root.
+    // Playouts run on a padded byte copy of the board, where a win check is a short run scan from the placed cell.
+    // Tree parallel threads share the tree without a lock: counters are atomic, a node is counted as visited on the
+    // way down (a virtual loss until its result arrives), and children are claimed and linked with compare-and-swap.
+    class MCTSEngine : public Engine
+    {
+    public:
+        static constexpr size_t DEFAULT_MAX_TREE_NODES = 1 << 20;
+        // UCB1 exploration constant; sqrt(2) in theory, a little less plays better with random playouts.
+        static constexpr double DEFAULT_EXPLORATION = 1.2;
+        // Iterations of a search that was given no limit at all.
+        static constexpr uint64_t DEFAULT_ITERATIONS = 20000;
+
+    private:
+        static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+        // Compact board values; the padding around the board holds WALL so run scans stop without bounds checks.
+        static constexpr uint8_t EMPTY = 0;
+        static constexpr uint8_t WALL = 3;
+        // Playout result when nobody won; the sides are 0 and 1.
+        static constexpr size_t DRAW = 2;
+
+        enum NodeResult : uint8_t
+        {
+            Ongoing = 0,
+            // The player who made the node's move won with it.
+            MoverWon = 1,
+            Drawn = 2
+        };
+
+        // parent, nextSibling, cell and result are written once, before the node is linked into the tree.
+        struct Node
+        {
+            uint32_t parent = NO_NODE;
+            std::atomic<uint32_t> firstChild{NO_NODE};
+            uint32_t nextSibling = NO_NODE;
+            // Iterations through the node, counted on the way down.
+            std::atomic<uint32_t> visits{0};
+            // Results for the player who made the move, in halves: 2 per win, 1 per draw.
+            std::atomic<uint32_t> halfWins{0};
+            // Index into m_MoveOrder where the scan for the next untried move resumes.
+            std::atomic<uint32_t> nextMove{0};
+            // Padded index of the cell the move was made on.
+            uint32_t cell = 0;
+            NodeResult result = Ongoing;
+        };
+
+        // Node pool that grows in fixed chunks, so nodes never move and threads can allocate without a lock.
+        class NodeArena
+        {
+        private:
+            static constexpr unsigned int CHUNK_SHIFT = 14;
+            static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_SHIFT;
+
+            size_t m_Capacity;
+            std::atomic<uint32_t> m_Size{0};
+            std::unique_ptr<std::atomic<Node *>[]> m_Chunks;
+            std::vector<std::unique_ptr<Node[]>> m_Owned;
+            // Only taken to add a chunk, once per CHUNK_SIZE nodes.
+            std::mutex m_ChunkMutex;
+
+        public:
+            explicit NodeArena(size_t capacity);
+
+            Node &operator[](uint32_t index) const;
+            size_t GetSize() const;
+            // Returns the index of a new node with default fields, or NO_NODE when the arena is full.
+            uint32_t Allocate();
+            // Gives back a node Allocate just returned. If another thread allocated after it, the node stays taken,
+            // unlinked, until the arena is cleared.
+            void Release(uint32_t index);
+            // Forgets every node but keeps the chunks for reuse.
+            void Clear();
+        };
+
+        // A tree and the spare arena its kept subtree is compacted into.
+        struct Tree
+        {
+            std::unique_ptr<NodeArena> arenas[2];
+            size_t current = 0;
+            uint32_t root = NO_NODE;
+
+            NodeArena &GetNodes() const { return *arenas[current]; }
+        };
+
+        // Playout state owned by one thread.
+        struct Worker
+        {
+            Tree *tree = nullptr;
+            std::vector<uint8_t> board;
+            // Padded indices of the empty cells at the root. Playouts draw from it by swapping picks to the back,
+            // which only reorders it, so it never has to be rebuilt.
+            std::vector<uint32_t> empty;
+            // Cells set on board by the current iteration, cleared when it ends.
+            std::vector<uint32_t> placed;
+            uint64_t randomState = 0;
+            uint64_t iterations = 0;
+            uint64_t playouts = 0;
+            unsigned int depth = 0;
+        };
+
+        size_t m_MaxTreeNodes;
+        double m_Exploration;
+        uint64_t m_Seed;
+        size_t m_ThreadCount = 1;
+        MCTSParallelism m_Parallelism = TreeParallel;
+
+        // One tree when tree parallel, one per thread when root parallel.
+        std::vector<std::unique_ptr<Tree>> m_Trees;
+
+        // Shape of the trees' board; the trees are dropped when a search comes with another.
+        unsigned char m_Rows = 0;
+        unsigned char m_Cols = 0;
+        unsigned char m_WinLength = 0;
+        size_t m_Stride = 0;
+        int m_Directions[4] = {};
+
+        // Board at the root, padded with WALL.
+        std::vector<uint8_t> m_RootBoard;
+        size_t m_RootSide = 0;
+        // Padded index of every cell, center first; untried moves are taken in this order.
+        std::vector<uint32_t> m_MoveOrder;
+        std::vector<uint32_t> m_RootEmpty;
+
+        SearchLimits m_Limits;
+        // maxNodes, or DEFAULT_ITERATIONS when the search has no limit at all.
+        uint64_t m_IterationLimit = 0;
+        // Iterations claimed by all threads, for the iteration budget.
+        std::atomic<uint64_t> m_Iterations{0};
+        std::chrono::steady_clock::time_point m_StartTime;
+
+    public:
+        // Constructors & Destructors
+        explicit MCTSEngine(size_t maxTreeNodes = DEFAULT_MAX_TREE_NODES, double exploration = DEFAULT_EXPLORATION, uint64_t seed = 1);
+        ~MCTSEngine() override = default;
+
+        // Getters & Setters
+    public:
+        size_t GetThreadCount() const;
+        void SetThreadCount(size_t threadCount);
+
+        MCTSParallelism GetParallelism() const;
+        void SetParallelism(MCTSParallelism parallelism);
+
+        // Nodes under the current roots, over all trees.
+        size_t GetTreeSize() const;
+        // Playouts already behind the current roots, e.g. kept from the previous search, over all trees.
+        uint32_t GetRootVisits() const;
+
+        // Public methods
+    public:
+        std::string GetName() const override;
+        // Runs until limits.maxNodes iterations over all threads, the time budget or the stop flag; maxDepth is not used.
+        SearchResult Search(Position &position, const SearchLimits &limits) override;
+
+        // Drops the trees.
+        void Reset();
+
+        // Private methods
+    private:
+        // Recomputes the padded layout and move order when the grid shape changes.
+        void SetShape(const Grid &grid);
+        void BuildBoard(const Position &position, std::vector<uint8_t> &board) const;
+        // Moves the tree's root to the node for board if the tree has it, or starts the tree over.
+        void SetRoot(Tree &tree, const std::vector<uint8_t> &board, size_t side) const;
+        // Copies the subtree of root to the front of the tree's spare arena and makes that arena current.
+        void CompactTree(Tree &tree, uint32_t root) const;
+
+        // Runs iterations on worker until the budget is gone.
+        void RunWorker(Worker &worker);
+        // One select, expand, playout and backup pass; returns the ply of the node it expanded or played from.
+        unsigned int RunIteration(Worker &worker);
+        uint32_t SelectChild(const NodeArena &nodes, uint32_t node) const;
+        // Adds the next untried move of node as a child, or returns NO_NODE if none is left or the arena is full.
+        uint32_t Expand(Worker &worker, uint32_t node, size_t emptyLeft, size_t side);
+        // Plays at random from the worker's board with side to move; returns the winning side or DRAW.
+        size_t Playout(Worker &worker, size_t side, size_t emptyLeft);
+        void Place(Worker &worker, uint32_t cell, size_t side) const;
+        bool IsWinAt(const std::vector<uint8_t> &board, uint32_t cell) const;
+
+        Move ToMove(uint32_t cell) const;
+        static uint64_t NextRandom(uint64_t &state);
+        // Whether the time budget or the stop flag ended the search; the iteration budget is claimed in RunWorker.
+        bool IsOutOfBudget() const;
+        double GetElapsedMilliseconds() const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "MappedFile.h"
+
+#ifdef GW_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    // Getters & Setters
+
+    bool MappedFile::IsOpen() const
+    {
+        return m_Data != nullptr;
+    }
+
+    const void *MappedFile::GetData() const
+    {
+        return m_Data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return m_Size;
+    }
+
+    // Public methods
+
+    bool MappedFile::Open(const std::string &path)
+    {
+        Close();
+
+#ifdef GW_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize = {};
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            // The view keeps the mapping alive once both handles are closed.
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr)
+            {
+                m_Data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        if (m_Data != nullptr)
+            m_Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return false;
+        struct stat status = {};
+        if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+            if (data != MAP_FAILED)
+            {
+                m_Data = data;
+                m_Size = static_cast<size_t>(status.st_size);
+            }
+        }
+        // The mapping stays valid once the descriptor is closed.
+        close(descriptor);
+#endif
+        return m_Data != nullptr;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data == nullptr)
+            return;
+#ifdef GW_PLATFORM_WINDOWS
+        UnmapViewOfFile(m_Data);
+#else
+        munmap(const_cast<void *>(m_Data), m_Size);
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+}
\ No newline at end of file
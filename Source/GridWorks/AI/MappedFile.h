@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace GridWorks
+{
+    // A whole file mapped read-only into memory; pages are loaded by the OS as they are read.
+    class MappedFile
+    {
+    private:
+        const void *m_Data = nullptr;
+        size_t m_Size = 0;
+
+    public:
+        // Constructors & Destructors
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // Getters & Setters
+    public:
+        bool IsOpen() const;
+        const void *GetData() const;
+        size_t GetSize() const;
+
+        // Public methods
+    public:
+        // Maps the file at path, closing the open one; returns false if it cannot be mapped or is empty.
+        bool Open(const std::string &path);
+        void Close();
+    };
+}
\ No newline at end of file
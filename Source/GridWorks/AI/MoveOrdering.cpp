@@ -0,0 +1,190 @@
+#include "MoveOrdering.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+
+    std::shared_ptr<const std::vector<Move>> MoveOrdering::GetCenterFirstOrder(const Grid &grid)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<unsigned char, unsigned char>, std::shared_ptr<const std::vector<Move>>> orders;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const std::vector<Move>> &order = orders[{grid.GetRows(), grid.GetCols()}];
+        if (order)
+            return order;
+
+        // Center cells sit on the most lines, so every search tries them first: they give alpha-beta its earliest
+        // cutoffs, proof numbers their quickest proofs and MCTS its most useful first children.
+        auto [centerRow, centerCol] = grid.GetCenterMostCoords();
+        std::vector<Move> moves(*GetRowMajorOrder(grid));
+        std::stable_sort(moves.begin(), moves.end(), [&](const Move &a, const Move &b)
+                         {
+                             auto distance = [&](const Move &move)
+                             { return std::max(std::abs(move.row - centerRow), std::abs(move.col - centerCol)); };
+                             return distance(a) < distance(b); });
+        order = std::make_shared<const std::vector<Move>>(std::move(moves));
+        return order;
+    }
+
+    std::shared_ptr<const std::vector<Move>> MoveOrdering::GetRowMajorOrder(const Grid &grid)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<unsigned char, unsigned char>, std::shared_ptr<const std::vector<Move>>> orders;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const std::vector<Move>> &order = orders[{grid.GetRows(), grid.GetCols()}];
+        if (order)
+            return order;
+
+        std::vector<Move> moves;
+        for (unsigned char row = 0; row < grid.GetRows(); ++row)
+        {
+            for (unsigned char col = 0; col < grid.GetCols(); ++col)
+            {
+                moves.push_back(Move{row, col});
+            }
+        }
+        order = std::make_shared<const std::vector<Move>>(std::move(moves));
+        return order;
+    }
+
+    // Getters & Setters
+
+    bool MoveOrdering::GetHeuristics() const
+    {
+        return m_Heuristics;
+    }
+
+    const std::vector<Move> &MoveOrdering::GetBaseOrder() const
+    {
+        return *m_BaseOrder;
+    }
+
+    const std::array<Move, MoveOrdering::KILLER_SLOTS> &MoveOrdering::GetKillers(unsigned int ply) const
+    {
+        static const std::array<Move, KILLER_SLOTS> noKillers = {NO_MOVE, NO_MOVE};
+        return ply < m_Killers.size() ? m_Killers[ply] : noKillers;
+    }
+
+    uint32_t MoveOrdering::GetHistory(size_t side, Move move) const
+    {
+        return m_History[side][ToCell(move)];
+    }
+
+    // Public methods
+
+    void MoveOrdering::Reset(const Grid &grid, bool heuristics)
+    {
+        m_BaseOrder = heuristics ? GetCenterFirstOrder(grid) : GetRowMajorOrder(grid);
+        m_Cols = grid.GetCols();
+        m_Heuristics = heuristics;
+        m_Killers.clear();
+        m_History[0].assign(grid.GetCellCount(), 0);
+        m_History[1].assign(grid.GetCellCount(), 0);
+        m_HistoryCells[0].clear();
+        m_HistoryCells[1].clear();
+    }
+
+    void MoveOrdering::Begin(const Position &position, unsigned int ply, Move tableMove)
+    {
+        if (m_Plies.size() <= ply)
+            m_Plies.resize(ply + 1);
+        PlyMoves &plyMoves = m_Plies[ply];
+        std::vector<Move> &front = plyMoves.front;
+        front.clear();
+        plyMoves.nextFront = 0;
+        plyMoves.nextBase = 0;
+        if (!m_Heuristics)
+            return;
+
+        if (position.IsLegalMove(tableMove.row, tableMove.col))
+            front.push_back(tableMove);
+        for (const Move &killer : GetKillers(ply))
+        {
+            if (!(killer == tableMove) && position.IsLegalMove(killer.row, killer.col))
+                front.push_back(killer);
+        }
+
+        const size_t side = position.GetSideToMove();
+        const std::vector<uint32_t> &history = m_History[side];
+        m_ByHistory.clear();
+        for (uint16_t cell : m_HistoryCells[side])
+        {
+            Move move = {static_cast<unsigned char>(cell / m_Cols), static_cast<unsigned char>(cell % m_Cols)};
+            if (position.IsLegalMove(move.row, move.col) && std::find(front.begin(), front.end(), move) == front.end())
+                m_ByHistory.push_back(move);
+        }
+        // Ties go to the lower cell so the order does not depend on when the cells got their first cutoff.
+        const size_t count = std::min(m_ByHistory.size(), HISTORY_MOVES);
+        std::partial_sort(m_ByHistory.begin(), m_ByHistory.begin() + count, m_ByHistory.end(), [&](const Move &a, const Move &b)
+                          { return history[ToCell(a)] != history[ToCell(b)] ? history[ToCell(a)] > history[ToCell(b)] : ToCell(a) < ToCell(b); });
+        front.insert(front.end(), m_ByHistory.begin(), m_ByHistory.begin() + count);
+    }
+
+    bool MoveOrdering::Next(const Position &position, unsigned int ply, Move &move)
+    {
+        PlyMoves &plyMoves = m_Plies[ply];
+        if (plyMoves.nextFront < plyMoves.front.size())
+        {
+            move = plyMoves.front[plyMoves.nextFront++];
+            return true;
+        }
+
+        const std::vector<Move> &base = *m_BaseOrder;
+        while (plyMoves.nextBase < base.size())
+        {
+            const Move &candidate = base[plyMoves.nextBase++];
+            if (!position.IsLegalMove(candidate.row, candidate.col) ||
+                std::find(plyMoves.front.begin(), plyMoves.front.end(), candidate) != plyMoves.front.end())
+                continue;
+            move = candidate;
+            return true;
+        }
+        return false;
+    }
+
+    void MoveOrdering::RecordCutoff(size_t side, Move move, unsigned int ply, unsigned int depth)
+    {
+        if (!m_Heuristics)
+            return;
+
+        if (m_Killers.size() <= ply)
+            m_Killers.resize(ply + 1, {NO_MOVE, NO_MOVE});
+        std::array<Move, KILLER_SLOTS> &killers = m_Killers[ply];
+        if (!(killers[0] == move))
+        {
+            killers[1] = killers[0];
+            killers[0] = move;
+        }
+
+        // Deeper cutoffs save more work, so they weigh more.
+        uint32_t &score = m_History[side][ToCell(move)];
+        if (score == 0)
+            m_HistoryCells[side].push_back(ToCell(move));
+        score = static_cast<uint32_t>(std::min<uint64_t>(score + static_cast<uint64_t>(depth) * depth, HISTORY_LIMIT));
+        if (score < HISTORY_LIMIT)
+            return;
+        for (size_t historySide = 0; historySide < 2; ++historySide)
+        {
+            std::vector<uint32_t> &scores = m_History[historySide];
+            for (uint32_t &value : scores)
+                value /= 2;
+            std::erase_if(m_HistoryCells[historySide], [&](uint16_t cell)
+                          { return scores[cell] == 0; });
+        }
+    }
+
+    // Private methods
+
+    uint16_t MoveOrdering::ToCell(Move move) const
+    {
+        return static_cast<uint16_t>(move.row * m_Cols + move.col);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AI/Position.h"
+#include "Grid/Grid.h"
+
+namespace GridWorks
+{
+    // Order in which a search tries the legal moves of a position, for any search over Grid positions.
+    // With the heuristics on, a node tries the transposition table's best move first, then the killer moves of its
+    // ply (moves that cut off a sibling), then the moves with the best history scores (how much search depth their
+    // cutoffs saved, per side and cell), and last the rest center first. Without them moves come row by row, as a
+    // baseline. Moves are handed out one at a time and the base order is walked lazily, so a cutoff on an early move
+    // costs nothing for the rest of a large board.
+    // Killers and history belong to one search thread; the base orders are cached and shared.
+    class MoveOrdering
+    {
+    public:
+        static constexpr size_t KILLER_SLOTS = 2;
+        // History moves tried ahead of the base order per node; the others keep their base order place.
+        static constexpr size_t HISTORY_MOVES = 8;
+        // Once a history score passes this every score is halved, so recent cutoffs keep counting more.
+        static constexpr uint32_t HISTORY_LIMIT = 1u << 30;
+        // Same as the transposition table's empty move.
+        static constexpr Move NO_MOVE = {255, 255};
+
+    private:
+        // Where the picking of one ply's moves stands.
+        struct PlyMoves
+        {
+            // Table move, killers and history moves, all legal, tried before the base order.
+            std::vector<Move> front;
+            size_t nextFront = 0;
+            size_t nextBase = 0;
+        };
+
+        std::shared_ptr<const std::vector<Move>> m_BaseOrder;
+        unsigned char m_Cols = 0;
+        bool m_Heuristics = true;
+        std::vector<std::array<Move, KILLER_SLOTS>> m_Killers;
+        // m_History[side][cell], cells numbered row * cols + col.
+        std::vector<uint32_t> m_History[2];
+        // Cells with a history score per side, so a node does not have to scan the board for them.
+        std::vector<uint16_t> m_HistoryCells[2];
+        // State of every ply on the current path, kept to avoid allocating per node.
+        std::vector<PlyMoves> m_Plies;
+        std::vector<Move> m_ByHistory;
+
+    public:
+        // Constructors & Destructors
+        MoveOrdering() = default;
+
+        // Every cell of the grid's shape sorted by distance from the center, cached per shape. Thread safe.
+        static std::shared_ptr<const std::vector<Move>> GetCenterFirstOrder(const Grid &grid);
+        // Every cell of the grid's shape row by row, cached per shape. Thread safe.
+        static std::shared_ptr<const std::vector<Move>> GetRowMajorOrder(const Grid &grid);
+
+        // Getters & Setters
+    public:
+        bool GetHeuristics() const;
+        // Center first when the heuristics are on, row major when they are off.
+        const std::vector<Move> &GetBaseOrder() const;
+        // Killer moves of ply, most recent first; empty slots hold NO_MOVE.
+        const std::array<Move, KILLER_SLOTS> &GetKillers(unsigned int ply) const;
+        uint32_t GetHistory(size_t side, Move move) const;
+
+        // Public methods
+    public:
+        // Prepares for a search over the grid's shape with no killers or history yet.
+        void Reset(const Grid &grid, bool heuristics = true);
+
+        // Starts picking the moves of the position searched at ply. tableMove may be NO_MOVE or illegal.
+        void Begin(const Position &position, unsigned int ply, Move tableMove);
+        // Next legal move of the ply, best guess first; false once every move was picked. The position has to be the
+        // one given to Begin, deeper plies taken back.
+        bool Next(const Position &position, unsigned int ply, Move &move);
+        // Records that move of side cut off the search at ply with depth plies left.
+        void RecordCutoff(size_t side, Move move, unsigned int ply, unsigned int depth);
+
+        // Private methods
+    private:
+        uint16_t ToCell(Move move) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "OpeningBook.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <durlib.h>
+
+#include "Grid/Zobrist.h"
+
+namespace GridWorks
+{
+    constexpr char BOOK_MAGIC[4] = {'G', 'W', 'O', 'B'};
+    constexpr uint32_t BOOK_VERSION = 1;
+
+    struct BookHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t recordCount;
+        unsigned char rows;
+        unsigned char cols;
+        unsigned char winLength;
+        unsigned char reserved[5];
+    };
+
+    // Records are read in place from the mapping, so their layout is the file format.
+    static_assert(sizeof(BookHeader) == 24 && sizeof(OpeningBook::Record) == 24);
+
+    // Getters & Setters
+
+    bool OpeningBook::IsOpen() const
+    {
+        return m_File.IsOpen();
+    }
+
+    size_t OpeningBook::GetEntryCount() const
+    {
+        return m_RecordCount;
+    }
+
+    unsigned char OpeningBook::GetRows() const
+    {
+        return m_Rows;
+    }
+
+    unsigned char OpeningBook::GetCols() const
+    {
+        return m_Cols;
+    }
+
+    unsigned char OpeningBook::GetWinLength() const
+    {
+        return m_WinLength;
+    }
+
+    // Public methods
+
+    bool OpeningBook::Open(const std::string &path)
+    {
+        Close();
+
+        if (!m_File.Open(path))
+        {
+            CLI_ERROR("Cannot map opening book {0}.", path);
+            return false;
+        }
+
+        const size_t size = m_File.GetSize();
+        BookHeader header = {};
+        if (size >= sizeof(header))
+            std::memcpy(&header, m_File.GetData(), sizeof(header));
+        if (size < sizeof(header) || std::memcmp(header.magic, BOOK_MAGIC, sizeof(header.magic)) != 0 || header.version != BOOK_VERSION ||
+            header.recordCount != (size - sizeof(header)) / sizeof(Record))
+        {
+            CLI_ERROR("{0} is not an opening book.", path);
+            m_File.Close();
+            return false;
+        }
+
+        m_Records = reinterpret_cast<const Record *>(static_cast<const char *>(m_File.GetData()) + sizeof(header));
+        m_RecordCount = header.recordCount;
+        m_Rows = header.rows;
+        m_Cols = header.cols;
+        m_WinLength = header.winLength;
+        return true;
+    }
+
+    void OpeningBook::Close()
+    {
+        m_File.Close();
+        m_Records = nullptr;
+        m_RecordCount = 0;
+        m_Rows = 0;
+        m_Cols = 0;
+        m_WinLength = 0;
+    }
+
+    bool OpeningBook::Probe(const Position &position, BookEntry &entry) const
+    {
+        const Grid &grid = position.GetGrid();
+        if (m_RecordCount == 0 || grid.GetRows() != m_Rows || grid.GetCols() != m_Cols || grid.GetWinLength() != m_WinLength)
+            return false;
+
+        const CanonicalForm canonical = GetKey(position);
+        const Record *end = m_Records + m_RecordCount;
+        const Record *record = std::lower_bound(m_Records, end, canonical.hash, [](const Record &record, uint64_t key)
+                                                { return record.key < key; });
+        if (record == end || record->key != canonical.hash)
+            return false;
+
+        // The canonical grid has the same shape, as only square grids have symmetries that swap rows and columns.
+        const Symmetry back = InverseSymmetry(canonical.symmetry);
+        entry.moves.clear();
+        for (uint16_t cell : record->cells)
+        {
+            if (cell == NO_CELL)
+                break;
+            auto [row, col] = ApplySymmetry(back, static_cast<unsigned char>(cell / m_Cols), static_cast<unsigned char>(cell % m_Cols), m_Rows, m_Cols);
+            // A taken cell means the key collided with another position.
+            if (!position.IsLegalMove(row, col))
+                return false;
+            entry.moves.push_back(Move{row, col});
+        }
+        entry.score = record->score;
+        entry.count = record->count;
+        return !entry.moves.empty();
+    }
+
+    CanonicalForm OpeningBook::GetKey(const Position &position)
+    {
+        return position.GetGrid().GetCanonicalForm(Zobrist::GetSideKey(position.GetSideToMove()));
+    }
+
+    // Getters & Setters
+
+    size_t OpeningBookBuilder::GetPositionCount() const
+    {
+        return m_Positions.size();
+    }
+
+    // Public methods
+
+    void OpeningBookBuilder::Add(const Position &position, Move move, int score)
+    {
+        const Grid &grid = position.GetGrid();
+        if (m_Positions.empty())
+        {
+            m_Rows = grid.GetRows();
+            m_Cols = grid.GetCols();
+            m_WinLength = grid.GetWinLength();
+        }
+        else if (grid.GetRows() != m_Rows || grid.GetCols() != m_Cols || grid.GetWinLength() != m_WinLength)
+        {
+            throw std::invalid_argument("OpeningBookBuilder positions must share their grid shape and win length");
+        }
+
+        const CanonicalForm canonical = OpeningBook::GetKey(position);
+        auto [row, col] = ApplySymmetry(canonical.symmetry, move.row, move.col, m_Rows, m_Cols);
+        const uint16_t cell = static_cast<uint16_t>(row * m_Cols + col);
+
+        std::vector<MoveStats> &moves = m_Positions[canonical.hash];
+        auto stats = std::find_if(moves.begin(), moves.end(), [cell](const MoveStats &stats)
+                                  { return stats.cell == cell; });
+        if (stats == moves.end())
+        {
+            moves.push_back(MoveStats{cell, 1, score});
+        }
+        else
+        {
+            ++stats->count;
+            stats->scoreSum += score;
+        }
+    }
+
+    bool OpeningBookBuilder::Contains(const Position &position) const
+    {
+        return m_Positions.contains(OpeningBook::GetKey(position).hash);
+    }
+
+    bool OpeningBookBuilder::Write(const std::string &path) const
+    {
+        std::vector<OpeningBook::Record> records;
+        records.reserve(m_Positions.size());
+        for (const auto &[key, positionMoves] : m_Positions)
+        {
+            std::vector<MoveStats> moves = positionMoves;
+            std::sort(moves.begin(), moves.end(), [](const MoveStats &a, const MoveStats &b)
+                      {
+                          if (a.count != b.count)
+                              return a.count > b.count;
+                          // a.scoreSum / a.count > b.scoreSum / b.count with the counts equal.
+                          return a.scoreSum > b.scoreSum; });
+
+            OpeningBook::Record record = {};
+            record.key = key;
+            std::fill(std::begin(record.cells), std::end(record.cells), OpeningBook::NO_CELL);
+            uint32_t count = 0;
+            for (size_t i = 0; i < moves.size(); ++i)
+            {
+                if (i < OpeningBook::BOOK_MOVES)
+                    record.cells[i] = moves[i].cell;
+                count += moves[i].count;
+            }
+            record.score = static_cast<int32_t>(moves.front().scoreSum / moves.front().count);
+            record.count = count;
+            records.push_back(record);
+        }
+        std::sort(records.begin(), records.end(), [](const OpeningBook::Record &a, const OpeningBook::Record &b)
+                  { return a.key < b.key; });
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            CLI_ERROR("Cannot open opening book {0} for writing.", path);
+            return false;
+        }
+
+        BookHeader header = {};
+        std::memcpy(header.magic, BOOK_MAGIC, sizeof(header.magic));
+        header.version = BOOK_VERSION;
+        header.recordCount = records.size();
+        header.rows = m_Rows;
+        header.cols = m_Cols;
+        header.winLength = m_WinLength;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(OpeningBook::Record)));
+        return static_cast<bool>(file);
+    }
+
+    void OpeningBookBuilder::Clear()
+    {
+        m_Positions.clear();
+        m_Rows = 0;
+        m_Cols = 0;
+        m_WinLength = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AI/MappedFile.h"
+#include "AI/Position.h"
+#include "Grid/Symmetry.h"
+
+namespace GridWorks
+{
+    struct BookEntry
+    {
+        // Best first, in the orientation of the probed position.
+        std::vector<Move> moves;
+        // Average score of the first move, from the point of view of the side to move.
+        int score = 0;
+        // Games or searches that reached the position.
+        uint32_t count = 0;
+    };
+
+    // Read-only opening book: a file of records sorted by canonical position hash, mapped into memory so opening a
+    // book copies nothing and a lookup is a binary search over the mapped records.
+    // Symmetric positions share a record; its moves are stored on the canonical grid and mapped back on lookup.
+    // A book is built for one grid shape and win length, and is written by OpeningBookBuilder.
+    class OpeningBook
+    {
+    public:
+        // Moves kept per position.
+        static constexpr size_t BOOK_MOVES = 4;
+        static constexpr uint16_t NO_CELL = 0xFFFF;
+
+        // A position in the file, after the header.
+        struct Record
+        {
+            uint64_t key;
+            // Cells (row * cols + col) on the canonical grid, best first, NO_CELL after the last move.
+            uint16_t cells[BOOK_MOVES];
+            int32_t score;
+            uint32_t count;
+        };
+
+    private:
+        MappedFile m_File;
+        const Record *m_Records = nullptr;
+        size_t m_RecordCount = 0;
+        unsigned char m_Rows = 0;
+        unsigned char m_Cols = 0;
+        unsigned char m_WinLength = 0;
+
+    public:
+        // Constructors & Destructors
+        OpeningBook() = default;
+
+        // Getters & Setters
+    public:
+        bool IsOpen() const;
+        size_t GetEntryCount() const;
+        unsigned char GetRows() const;
+        unsigned char GetCols() const;
+        unsigned char GetWinLength() const;
+
+        // Public methods
+    public:
+        // Maps the book at path, closing the open one; returns false and stays closed if the file is missing or not
+        // a book.
+        bool Open(const std::string &path);
+        void Close();
+
+        // Looks the position up; returns false if it is not in the book or the book is for another grid.
+        bool Probe(const Position &position, BookEntry &entry) const;
+
+        // Key of a position in a book: its canonical hash with the side to move, and the symmetry that maps the
+        // position onto the canonical grid.
+        static CanonicalForm GetKey(const Position &position);
+    };
+
+    // Collects the moves picked by searches or self-play games and writes them as an OpeningBook file.
+    class OpeningBookBuilder
+    {
+    private:
+        struct MoveStats
+        {
+            uint16_t cell;
+            uint32_t count;
+            int64_t scoreSum;
+        };
+
+        // Moves picked in every position, by book key.
+        std::unordered_map<uint64_t, std::vector<MoveStats>> m_Positions;
+        unsigned char m_Rows = 0;
+        unsigned char m_Cols = 0;
+        unsigned char m_WinLength = 0;
+
+    public:
+        // Getters & Setters
+        size_t GetPositionCount() const;
+
+        // Public methods
+    public:
+        // Records that move was picked in position with score; every position of a book has the same grid shape
+        // and win length, so a position of another throws std::invalid_argument.
+        void Add(const Position &position, Move move, int score);
+        bool Contains(const Position &position) const;
+
+        // Writes the book to path, keeping the moves picked most often, then those with the best average score;
+        // returns false if the file cannot be written.
+        bool Write(const std::string &path) const;
+        void Clear();
+    };
+}
\ No newline at end of file
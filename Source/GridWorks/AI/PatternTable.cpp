@@ -0,0 +1,110 @@
+#include "PatternTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+    PatternTable::PatternTable(unsigned char length)
+        : m_Length(length)
+    {
+        if (length == 0 || length > MAX_LENGTH)
+        {
+            throw std::invalid_argument("Pattern tables cover lines of 1 to 8 cells");
+        }
+
+        size_t codeCount = 1;
+        for (unsigned char i = 0; i < length; ++i)
+            codeCount *= 3;
+        m_Entries.resize(codeCount);
+
+        for (size_t code = 0; code < codeCount; ++code)
+        {
+            PatternEntry &entry = m_Entries[code];
+            unsigned int stones[2] = {};
+            uint16_t stoneMask = 0;
+            size_t digits = code;
+            for (unsigned char i = 0; i < length; ++i, digits /= 3)
+            {
+                if (digits % 3 == 0)
+                {
+                    entry.emptyMask |= static_cast<uint16_t>(1u << i);
+                    continue;
+                }
+                ++stones[digits % 3 - 1];
+                stoneMask |= static_cast<uint16_t>(1u << i);
+            }
+
+            if (stones[0] > 0 && stones[1] > 0)
+                continue;
+            if (stones[0] + stones[1] == 0)
+            {
+                entry.pattern = EmptyPattern;
+                continue;
+            }
+
+            entry.side = stones[0] > 0 ? 0 : 1;
+            const unsigned int count = stones[entry.side];
+            // The evaluation weight: every stone more on an open line counts eight times as much.
+            const int32_t weight = 1 << std::min(3 * static_cast<int>(count), 30);
+            entry.score = entry.side == 0 ? weight : -weight;
+
+            if (count == length)
+                entry.pattern = FivePattern;
+            else if (count + 1 == length)
+                entry.pattern = FourPattern;
+            else if (count + 2 == length)
+            {
+                // Stones next to each other leave no gap between the lowest and highest stone.
+                const unsigned int span = 16 - std::countl_zero(stoneMask) - std::countr_zero(stoneMask);
+                entry.pattern = span == count ? ThreePattern : BrokenThreePattern;
+            }
+            else
+                entry.pattern = FarPattern;
+        }
+    }
+
+    std::shared_ptr<const PatternTable> PatternTable::Get(unsigned char length)
+    {
+        if (length == 0 || length > MAX_LENGTH)
+            return nullptr;
+
+        static std::mutex mutex;
+        static std::map<unsigned char, std::shared_ptr<const PatternTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const PatternTable> &table = tables[length];
+        if (!table)
+            table = std::make_shared<const PatternTable>(length);
+        return table;
+    }
+
+    // Getters & Setters
+
+    unsigned char PatternTable::GetLength() const
+    {
+        return m_Length;
+    }
+
+    size_t PatternTable::GetEntryCount() const
+    {
+        return m_Entries.size();
+    }
+
+    // Public methods
+
+    uint16_t PatternTable::Encode(const std::vector<uint8_t> &sides)
+    {
+        uint16_t code = 0;
+        for (size_t i = 0; i < sides.size() && i < MAX_LENGTH; ++i)
+        {
+            if (sides[i] < 2)
+                code = static_cast<uint16_t>(code + DIGIT_WEIGHTS[i] * (sides[i] + 1));
+        }
+        return code;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GridWorks
+{
+    // Shape of the stones in one win line, named after five in a row: a four is one stone short of the win
+    // whatever the win length.
+    enum LinePattern : uint8_t
+    {
+        // Stones of both sides; nobody can win on the line any more.
+        DeadPattern = 0,
+        EmptyPattern = 1,
+        // Three or more stones short of the win.
+        FarPattern = 2,
+        // Two stones short, with an empty cell between the stones.
+        BrokenThreePattern = 3,
+        // Two stones short, the stones next to each other.
+        ThreePattern = 4,
+        FourPattern = 5,
+        FivePattern = 6
+    };
+
+    struct PatternEntry
+    {
+        LinePattern pattern = DeadPattern;
+        // Side whose stones are on the line; 0 for dead and empty lines.
+        uint8_t side = 0;
+        // Bit i is set when cell i of the line is empty.
+        uint16_t emptyMask = 0;
+        // Static score of the line for side 0; positive when side 0 owns it.
+        int32_t score = 0;
+    };
+
+    // Threat class and score of every possible win line, looked up by the line's code instead of walking its cells.
+    // A line of length cells is coded in base 3, cell i adding 3^i times 0 when empty, 1 for a stone of side 0 and
+    // 2 for side 1, so a move changes the code by a single addition. Tables exist up to MAX_LENGTH, which covers
+    // gomoku-sized wins; longer lines are left to the callers' own loops.
+    class PatternTable
+    {
+    public:
+        static constexpr unsigned char MAX_LENGTH = 8;
+        // Value of a stone of side 0 on cell i of a line; twice that for side 1.
+        static constexpr std::array<uint16_t, MAX_LENGTH> DIGIT_WEIGHTS = {1, 3, 9, 27, 81, 243, 729, 2187};
+
+    private:
+        unsigned char m_Length;
+        std::vector<PatternEntry> m_Entries;
+
+    public:
+        // Constructors & Destructors
+        explicit PatternTable(unsigned char length);
+
+        // Returns the cached table for the length, building it on first use, or null above MAX_LENGTH. Thread safe.
+        static std::shared_ptr<const PatternTable> Get(unsigned char length);
+
+        // Getters & Setters
+    public:
+        unsigned char GetLength() const;
+        size_t GetEntryCount() const;
+
+        const PatternEntry &Lookup(uint16_t code) const { return m_Entries[code]; }
+
+        // Public methods
+    public:
+        // Code of a line from one side per cell: 0 or 1, or any other value for an empty cell.
+        static uint16_t Encode(const std::vector<uint8_t> &sides);
+    };
+}
\ No newline at end of file
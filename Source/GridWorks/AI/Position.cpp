@@ -0,0 +1,139 @@
+#include "Position.h"
+
+#include <stdexcept>
+
+#include <durlib.h>
+
+#include "Grid/Zobrist.h"
+#include "GameLogic/TurnManager.h"
+#include "Player/Moves.h"
+#include "Player/Player.h"
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+    Position::Position(const Grid &grid, const std::vector<char> &playerChars, size_t sideToMove)
+        : m_Grid(grid), m_PlayerChars(playerChars), m_SideToMove(sideToMove)
+    {
+        if (m_PlayerChars.empty())
+        {
+            throw std::invalid_argument("Position needs at least one player");
+        }
+        m_SideToMove %= m_PlayerChars.size();
+        m_History.reserve(m_Grid.GetCellCount());
+    }
+
+    Position::Position(const Grid *grid, const TurnManager *turnManager)
+        : m_Grid(*grid), m_SideToMove(turnManager->GetCurrentTurn())
+    {
+        for (Player *player : turnManager->GetPlayerPtrs())
+        {
+            m_PlayerChars.push_back(MoveTypeEnumToChar(player->GetPlayerMoveType()));
+        }
+        m_History.reserve(m_Grid.GetCellCount());
+    }
+
+    // Getters & Setters
+
+    const Grid &Position::GetGrid() const
+    {
+        return m_Grid;
+    }
+
+    size_t Position::GetPlayerCount() const
+    {
+        return m_PlayerChars.size();
+    }
+
+    char Position::GetPlayerChar(size_t side) const
+    {
+        return m_PlayerChars[side];
+    }
+
+    size_t Position::GetSideToMove() const
+    {
+        return m_SideToMove;
+    }
+
+    char Position::GetSideToMoveChar() const
+    {
+        return m_PlayerChars[m_SideToMove];
+    }
+
+    size_t Position::GetPly() const
+    {
+        return m_History.size();
+    }
+
+    Move Position::GetLastMove() const
+    {
+        auto [row, col] = m_Grid.GetLastChangedChar();
+        return Move{row, col};
+    }
+
+    uint64_t Position::GetHash() const
+    {
+        return m_Grid.GetHash() ^ Zobrist::GetSideKey(m_SideToMove);
+    }
+
+    // Public methods
+
+    bool Position::IsLegalMove(unsigned char row, unsigned char col) const
+    {
+        return row < m_Grid.GetRows() && col < m_Grid.GetCols() && m_Grid.GetCharAt(row, col) == m_Grid.GetDefaultChar();
+    }
+
+    void Position::GenerateMoves(std::vector<Move> &moves) const
+    {
+        GridView view = m_Grid.GetGrid();
+        char defaultChar = m_Grid.GetDefaultChar();
+        for (unsigned char row = 0; row < view.rows; ++row)
+        {
+            const char *cells = view[row];
+            for (unsigned char col = 0; col < view.cols; ++col)
+            {
+                if (cells[col] == defaultChar)
+                    moves.push_back(Move{row, col});
+            }
+        }
+    }
+
+    void Position::MakeMove(unsigned char row, unsigned char col)
+    {
+        DEBUG_ASSERT(IsLegalMove(row, col), "Illegal search move at ({0}, {1}).", row, col);
+
+        m_History.push_back(UndoRecord{Move{row, col}, m_Grid.GetCharAt(row, col), m_Grid.GetLastChangedChar()});
+        m_Grid.SetCharAt(row, col, m_PlayerChars[m_SideToMove]);
+        m_SideToMove = m_SideToMove + 1 == m_PlayerChars.size() ? 0 : m_SideToMove + 1;
+    }
+
+    void Position::MakeMove(Move move)
+    {
+        MakeMove(move.row, move.col);
+    }
+
+    void Position::UnmakeMove()
+    {
+        DEBUG_ASSERT(!m_History.empty(), "UnmakeMove called without a move to take back.");
+
+        const UndoRecord &record = m_History.back();
+        // SetCharAt reverts the bitsets, occupied count and hashes along with the cell.
+        m_Grid.SetCharAt(record.move.row, record.move.col, record.previousChar);
+        m_Grid.SetLastChangedChar(record.previousLastChanged.first, record.previousLastChanged.second);
+        m_SideToMove = m_SideToMove == 0 ? m_PlayerChars.size() - 1 : m_SideToMove - 1;
+        m_History.pop_back();
+    }
+
+    bool Position::IsLastMoveWin() const
+    {
+        if (m_History.empty())
+            return false;
+        const Move &move = m_History.back().move;
+        return m_Grid.CheckForRecurringCharsAround(move.row, move.col);
+    }
+
+    bool Position::IsFull() const
+    {
+        return m_Grid.IsFull();
+    }
+}
\ No newline at end of file
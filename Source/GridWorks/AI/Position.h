@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Grid/Grid.h"
+
+namespace GridWorks
+{
+    // Forward declarations
+    class TurnManager;
+
+    struct Move
+    {
+        unsigned char row;
+        unsigned char col;
+
+        bool operator==(const Move &other) const { return row == other.row && col == other.col; }
+    };
+
+    // Board state for tree search.
+    // Owns its own Grid copy plus the turn order, and applies moves with MakeMove/UnmakeMove instead of going through GameLogic.
+    // Both are O(1) and allocation free: the cell, last changed coords, hash, occupied count and side to move are all restored on unmake.
+    class Position
+    {
+    private:
+        struct UndoRecord
+        {
+            Move move;
+            char previousChar;
+            std::pair<unsigned char, unsigned char> previousLastChanged;
+        };
+
+        Grid m_Grid;
+        // Char of every player in turn order.
+        std::vector<char> m_PlayerChars;
+        size_t m_SideToMove = 0;
+        // Moves made on this position, reserved to the cell count.
+        std::vector<UndoRecord> m_History;
+
+    public:
+        // Constructors & Destructors
+        Position(const Grid &grid, const std::vector<char> &playerChars, size_t sideToMove = 0);
+        // Snapshot of a running game.
+        Position(const Grid *grid, const TurnManager *turnManager);
+
+        // Getters & Setters
+    public:
+        const Grid &GetGrid() const;
+
+        size_t GetPlayerCount() const;
+        char GetPlayerChar(size_t side) const;
+
+        size_t GetSideToMove() const;
+        char GetSideToMoveChar() const;
+
+        // Number of moves made since the position was created.
+        size_t GetPly() const;
+        Move GetLastMove() const;
+
+        // Same key as TurnManager::GetPositionHash for the same grid and side to move.
+        uint64_t GetHash() const;
+
+        // Public methods
+    public:
+        bool IsLegalMove(unsigned char row, unsigned char col) const;
+        // Appends every empty cell in row-major order.
+        void GenerateMoves(std::vector<Move> &moves) const;
+
+        // Places the side to move's char and passes the turn; the cell must be empty.
+        void MakeMove(unsigned char row, unsigned char col);
+        void MakeMove(Move move);
+        // Takes back the last MakeMove.
+        void UnmakeMove();
+
+        // Whether the last move completed a line of the grid's win length.
+        bool IsLastMoveWin() const;
+        bool IsFull() const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,422 @@
+#include "ProofNumberSolver.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <durlib.h>
+
+#include "AI/MoveOrdering.h"
+#include "Grid/Zobrist.h"
+
+namespace GridWorks
+{
+    // Mixed into the key of every position so the entries of each pass stay apart: [attacker][draws for attacker].
+    constexpr uint64_t PASS_KEYS[2][2] = {{0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL}, {0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL}};
+    // A child's delta threshold is at least 1 + 1/2 of its sibling's delta, so the search does not keep switching
+    // between two children of almost equal cost (df-pn 1+epsilon).
+    constexpr uint64_t EPSILON_DIVISOR = 2;
+
+    constexpr char CHECKPOINT_MAGIC[4] = {'G', 'W', 'P', 'N'};
+    constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    struct CheckpointHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t entryCount;
+    };
+
+    // Constructors & Destructors
+    ProofNumberSolver::ProofNumberSolver(size_t megabytes)
+    {
+        Resize(megabytes);
+    }
+
+    // Getters & Setters
+
+    size_t ProofNumberSolver::GetEntryCount() const
+    {
+        return m_Entries.size();
+    }
+
+    size_t ProofNumberSolver::GetSizeInBytes() const
+    {
+        return m_Entries.size() * sizeof(Entry);
+    }
+
+    // Public methods
+
+    ProofResult ProofNumberSolver::Solve(Position &position, const SearchLimits &limits)
+    {
+        if (position.GetPlayerCount() != 2)
+        {
+            throw std::invalid_argument("ProofNumberSolver only supports two players");
+        }
+
+        m_Limits = limits;
+        m_Stats = ProofStats();
+        m_Aborted = false;
+        m_StartTime = std::chrono::steady_clock::now();
+        m_MoveOrder = MoveOrdering::GetCenterFirstOrder(position.GetGrid());
+        m_LineCounts.Reset(position);
+
+        ProofResult result;
+        if (position.IsFull())
+        {
+            result.value = ProvenDraw;
+            result.stats = m_Stats;
+            return result;
+        }
+
+        // First pass: does the side to move win? If not, the second pass counts a draw as reaching the goal.
+        uint32_t phi = 0;
+        uint32_t delta = 0;
+        m_Attacker = position.GetSideToMove();
+        m_DrawsForAttacker = false;
+        RunPass(position, phi, delta);
+        if (!m_Aborted && phi == 0)
+        {
+            result.value = ProvenWin;
+            result.bestMove = m_RootMove;
+        }
+        else if (!m_Aborted)
+        {
+            m_DrawsForAttacker = true;
+            RunPass(position, phi, delta);
+            if (!m_Aborted && phi == 0)
+            {
+                result.value = ProvenDraw;
+                result.bestMove = m_RootMove;
+            }
+            else if (!m_Aborted)
+            {
+                // Every move loses; take the first legal one, center first.
+                result.value = ProvenLoss;
+                result.bestMove = *std::find_if(m_MoveOrder->begin(), m_MoveOrder->end(), [&](const Move &move)
+                                                { return position.IsLegalMove(move.row, move.col); });
+            }
+        }
+
+        result.stats = m_Stats;
+        result.stats.rootProof = phi;
+        result.stats.rootDisproof = delta;
+        result.stats.elapsedMilliseconds = GetElapsedMilliseconds();
+        return result;
+    }
+
+    bool ProofNumberSolver::SaveCheckpoint(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            CLI_ERROR("Cannot open proof checkpoint {0} for writing.", path);
+            return false;
+        }
+
+        CheckpointHeader header = {};
+        std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version = CHECKPOINT_VERSION;
+        header.entryCount = m_Entries.size();
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(m_Entries.data()), static_cast<std::streamsize>(GetSizeInBytes()));
+        return static_cast<bool>(file);
+    }
+
+    bool ProofNumberSolver::LoadCheckpoint(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        CheckpointHeader header = {};
+        if (!file || !file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        {
+            CLI_ERROR("Cannot read proof checkpoint {0}.", path);
+            return false;
+        }
+
+        // The entry count is a power of two number of buckets, as Resize makes it.
+        const uint64_t bucketCount = header.entryCount / BUCKET_SIZE;
+        if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 || header.version != CHECKPOINT_VERSION ||
+            bucketCount == 0 || header.entryCount % BUCKET_SIZE != 0 || (bucketCount & (bucketCount - 1)) != 0)
+        {
+            CLI_ERROR("{0} is not a proof checkpoint.", path);
+            return false;
+        }
+
+        std::vector<Entry> entries(header.entryCount);
+        if (!file.read(reinterpret_cast<char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry))))
+        {
+            CLI_ERROR("Proof checkpoint {0} is truncated.", path);
+            return false;
+        }
+
+        m_Entries.swap(entries);
+        m_BucketMask = bucketCount - 1;
+        return true;
+    }
+
+    void ProofNumberSolver::Clear()
+    {
+        std::fill(m_Entries.begin(), m_Entries.end(), Entry());
+    }
+
+    void ProofNumberSolver::Resize(size_t megabytes)
+    {
+        size_t buckets = 1;
+        while (buckets * 2 * BUCKET_SIZE * sizeof(Entry) <= megabytes * 1024 * 1024)
+            buckets *= 2;
+        m_Entries.assign(buckets * BUCKET_SIZE, Entry());
+        m_BucketMask = buckets - 1;
+    }
+
+    // Private methods
+
+    void ProofNumberSolver::RunPass(Position &position, uint32_t &phi, uint32_t &delta)
+    {
+        const Grid &grid = position.GetGrid();
+        size_t emptyCells = grid.GetCellCount() - grid.GetOccupiedCount();
+        if (m_Children.size() <= emptyCells)
+            m_Children.resize(emptyCells + 1);
+
+        m_RootMove = m_MoveOrder->front();
+        SearchNode(position, GetKey(position), INFINITE_PROOF, INFINITE_PROOF, 0, phi, delta);
+    }
+
+    void ProofNumberSolver::SearchNode(Position &position, uint64_t key, uint32_t thresholdPhi, uint32_t thresholdDelta, unsigned int ply, uint32_t &phi, uint32_t &delta)
+    {
+        const uint64_t startNodes = m_Stats.nodes++;
+        m_Stats.depth = std::max(m_Stats.depth, ply);
+        GenerateChildren(position, ply);
+        std::vector<Child> &children = m_Children[ply];
+
+        while (true)
+        {
+            // phi is the cheapest child to disprove for the opponent, delta the cost of disproving every child.
+            uint32_t secondDelta = INFINITE_PROOF;
+            uint64_t sumPhi = 0;
+            size_t best = 0;
+            phi = INFINITE_PROOF;
+            for (size_t index = 0; index < children.size(); ++index)
+            {
+                Child &child = children[index];
+                // A miss keeps the values the child was last seen with.
+                if (!child.terminal)
+                    Probe(child.key, child.phi, child.delta);
+
+                if (child.delta < phi)
+                {
+                    secondDelta = phi;
+                    phi = child.delta;
+                    best = index;
+                }
+                else if (child.delta < secondDelta)
+                {
+                    secondDelta = child.delta;
+                }
+                sumPhi += child.phi;
+            }
+            delta = static_cast<uint32_t>(std::min<uint64_t>(sumPhi, INFINITE_PROOF));
+
+            bool finished = phi >= thresholdPhi || delta >= thresholdDelta;
+            if (!finished && !m_Aborted && IsOutOfBudget())
+                m_Aborted = true;
+            if (finished || m_Aborted)
+            {
+                if (phi == 0)
+                {
+                    ++m_Stats.proofs;
+                    if (ply == 0)
+                        m_RootMove = children[best].move;
+                }
+                else if (delta == 0)
+                {
+                    ++m_Stats.disproofs;
+                }
+                Store(key, phi, delta, m_Stats.nodes - startNodes);
+                return;
+            }
+
+            // The child may grow until it alone would push our delta past its threshold, or until it stops being
+            // the cheapest child to disprove.
+            Child &child = children[best];
+            uint64_t childThresholdPhi = std::min<uint64_t>(static_cast<uint64_t>(thresholdDelta) - delta + child.phi, INFINITE_PROOF);
+            uint64_t childThresholdDelta = std::min<uint64_t>(thresholdPhi, std::max<uint64_t>(secondDelta + 1ULL, secondDelta + secondDelta / EPSILON_DIVISOR));
+
+            Play(position, child.move);
+            SearchNode(position, child.key, static_cast<uint32_t>(childThresholdPhi), static_cast<uint32_t>(childThresholdDelta), ply + 1, child.phi, child.delta);
+            Undo(position);
+        }
+    }
+
+    void ProofNumberSolver::GenerateChildren(Position &position, unsigned int ply)
+    {
+        std::vector<Child> &children = m_Children[ply];
+        children.clear();
+
+        // A line one stone short of a win decides the node: the side to move completes its own, or has to block
+        // the opponent's, and every other move loses at once. Only those moves are children.
+        const size_t side = position.GetSideToMove();
+        const size_t other = side ^ 1;
+        const unsigned char winLength = position.GetGrid().GetWinLength();
+        m_Forced.clear();
+        for (size_t pass = 0; pass < 2 && m_Forced.empty(); ++pass)
+        {
+            const size_t threatening = pass == 0 ? side : other;
+            const WinLineTable &lines = m_LineCounts.GetLines();
+            for (size_t line = 0; line < m_LineCounts.GetLineCount(); ++line)
+            {
+                if (m_LineCounts.HasPatterns())
+                {
+                    // A four's one empty cell is the move, no need to look at the grid.
+                    const PatternEntry &pattern = m_LineCounts.GetPattern(line);
+                    if (pattern.pattern != FourPattern || pattern.side != threatening)
+                        continue;
+                    auto [row, col] = lines.FromCell(lines.GetLineCells(line)[std::countr_zero(pattern.emptyMask)]);
+                    if (std::find(m_Forced.begin(), m_Forced.end(), Move{row, col}) == m_Forced.end())
+                        m_Forced.push_back(Move{row, col});
+                }
+                else
+                {
+                    if (m_LineCounts.GetCount(threatening, line) + 1 != winLength || m_LineCounts.GetCount(threatening ^ 1, line) != 0)
+                        continue;
+                    for (uint16_t cell : lines.GetLineCells(line))
+                    {
+                        auto [row, col] = lines.FromCell(cell);
+                        if (position.IsLegalMove(row, col) && std::find(m_Forced.begin(), m_Forced.end(), Move{row, col}) == m_Forced.end())
+                            m_Forced.push_back(Move{row, col});
+                    }
+                }
+                // One winning move is enough.
+                if (pass == 0)
+                    break;
+            }
+        }
+
+        // Unexplored children start at phi 1 and delta the number of moves left: the side to move proves its goal
+        // with one good move, but has to see every move fail to be disproven.
+        const Grid &grid = position.GetGrid();
+        const uint32_t movesLeft = static_cast<uint32_t>(grid.GetCellCount() - grid.GetOccupiedCount() - 1);
+        const std::vector<Move> &moves = m_Forced.empty() ? *m_MoveOrder : m_Forced;
+        for (const Move &move : moves)
+        {
+            if (!position.IsLegalMove(move.row, move.col))
+                continue;
+
+            Play(position, move);
+            Child child = {move, 0, false, 1, std::max<uint32_t>(movesLeft, 1)};
+            child.terminal = ScoreTerminal(position, child.phi, child.delta);
+            if (!child.terminal)
+            {
+                child.key = GetKey(position);
+                Probe(child.key, child.phi, child.delta);
+            }
+            Undo(position);
+            // Moves that lead to the same position up to symmetry are one child.
+            if (!child.terminal && std::any_of(children.begin(), children.end(), [&](const Child &sibling)
+                                               { return !sibling.terminal && sibling.key == child.key; }))
+                continue;
+            children.push_back(child);
+        }
+    }
+
+    bool ProofNumberSolver::ScoreTerminal(const Position &position, uint32_t &phi, uint32_t &delta) const
+    {
+        // The attacker reaches its goal with a win, or with a draw in the second pass. The game is decided as soon
+        // as the side that still needs a line has none left to complete.
+        const size_t defender = m_Attacker ^ 1;
+        bool attackerReached;
+        if (position.IsLastMoveWin())
+            attackerReached = position.GetSideToMove() == defender;
+        else if (m_DrawsForAttacker && (m_LineCounts.GetOpenLineCount(defender) == 0 || position.IsFull()))
+            attackerReached = true;
+        else if (!m_DrawsForAttacker && (m_LineCounts.GetOpenLineCount(m_Attacker) == 0 || position.IsFull()))
+            attackerReached = false;
+        else
+            return false;
+
+        if (attackerReached == (position.GetSideToMove() == m_Attacker))
+        {
+            phi = 0;
+            delta = INFINITE_PROOF;
+        }
+        else
+        {
+            phi = INFINITE_PROOF;
+            delta = 0;
+        }
+        return true;
+    }
+
+    void ProofNumberSolver::Play(Position &position, Move move)
+    {
+        m_LineCounts.Add(position.GetSideToMove(), move);
+        position.MakeMove(move);
+    }
+
+    void ProofNumberSolver::Undo(Position &position)
+    {
+        const Move move = position.GetLastMove();
+        position.UnmakeMove();
+        m_LineCounts.Remove(position.GetSideToMove(), move);
+    }
+
+    uint64_t ProofNumberSolver::GetKey(const Position &position) const
+    {
+        // The shape keeps the entries of different grids apart.
+        const Grid &grid = position.GetGrid();
+        uint64_t salt = Zobrist::GetSideKey(position.GetSideToMove()) ^ PASS_KEYS[m_Attacker][m_DrawsForAttacker] ^ Zobrist::GetShapeKey(grid.GetRows(), grid.GetCols(), grid.GetWinLength());
+        return grid.GetCanonicalForm(salt).hash;
+    }
+
+    bool ProofNumberSolver::Probe(uint64_t key, uint32_t &phi, uint32_t &delta)
+    {
+        ++m_Stats.tableProbes;
+        const Entry *bucket = &m_Entries[(key & m_BucketMask) * BUCKET_SIZE];
+        for (size_t slot = 0; slot < BUCKET_SIZE; ++slot)
+        {
+            // phi and delta are never both 0, so an empty slot never matches.
+            if (bucket[slot].key == key && (bucket[slot].phi | bucket[slot].delta) != 0)
+            {
+                ++m_Stats.tableHits;
+                phi = bucket[slot].phi;
+                delta = bucket[slot].delta;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ProofNumberSolver::Store(uint64_t key, uint32_t phi, uint32_t delta, uint64_t work)
+    {
+        Entry *bucket = &m_Entries[(key & m_BucketMask) * BUCKET_SIZE];
+        Entry *replace = bucket;
+        for (size_t slot = 0; slot < BUCKET_SIZE; ++slot)
+        {
+            if (bucket[slot].key == key)
+            {
+                replace = &bucket[slot];
+                work += bucket[slot].work;
+                break;
+            }
+            if (bucket[slot].work < replace->work)
+                replace = &bucket[slot];
+        }
+        *replace = Entry{key, phi, delta, static_cast<uint32_t>(std::min<uint64_t>(work, UINT32_MAX))};
+    }
+
+    bool ProofNumberSolver::IsOutOfBudget() const
+    {
+        if (m_Limits.maxNodes != 0 && m_Stats.nodes >= m_Limits.maxNodes)
+            return true;
+        if (m_Limits.stop != nullptr && m_Limits.stop->load(std::memory_order_relaxed))
+            return true;
+        return m_Limits.maxMilliseconds > 0.0 && GetElapsedMilliseconds() >= m_Limits.maxMilliseconds;
+    }
+
+    double ProofNumberSolver::GetElapsedMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime).count();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AI/Position.h"
+#include "AI/LineCounts.h"
+#include "AI/SearchLimits.h"
+
+namespace GridWorks
+{
+    // Game-theoretic value of a position for the side to move.
+    enum ProofValue
+    {
+        // The solver ran out of budget first.
+        Unproven = 0,
+        ProvenWin = 1,
+        ProvenDraw = 2,
+        ProvenLoss = 3
+    };
+
+    struct ProofStats
+    {
+        // Positions expanded, over both passes.
+        uint64_t nodes = 0;
+        // Expansions that ended with the position proven or disproven for its side to move.
+        uint64_t proofs = 0;
+        uint64_t disproofs = 0;
+        uint64_t tableProbes = 0;
+        uint64_t tableHits = 0;
+        // Proof and disproof numbers of the root after the last pass, from the side to move's point of view.
+        uint32_t rootProof = 0;
+        uint32_t rootDisproof = 0;
+        // Deepest ply expanded.
+        unsigned int depth = 0;
+        double elapsedMilliseconds = 0.0;
+
+        double GetNodesPerSecond() const
+        {
+            return elapsedMilliseconds > 0.0 ? nodes * 1000.0 / elapsedMilliseconds : 0.0;
+        }
+    };
+
+    struct ProofResult
+    {
+        ProofValue value = Unproven;
+        // A move that keeps the value: a winning move for a win, a drawing move for a draw.
+        Move bestMove = {0, 0};
+        ProofStats stats;
+    };
+
+    // Depth-first proof-number search (df-pn) that proves positions won, drawn or lost.
+    // A proof only answers yes or no, so a solve runs up to two passes: whether the side to move wins, and if not,
+    // whether it at least draws. Proof and disproof numbers live in a bounded transposition table keyed by the
+    // canonical position, so symmetric positions share their entry; when it is full the entries that took the least
+    // work are replaced first. Nodes only get the forced moves when a line is one stone short of a win, and a pass
+    // ends at a node as soon as the side that needs a win has no line left to complete.
+    // The table is all the state a solve needs, so saving it is a checkpoint: a solve that ran out of budget continues
+    // where it stopped once the checkpoint is loaded.
+    class ProofNumberSolver
+    {
+    public:
+        static constexpr size_t DEFAULT_SIZE_MB = 64;
+        // Proof number of a position that can no longer be proven.
+        static constexpr uint32_t INFINITE_PROOF = 0x7FFFFFFF;
+
+    private:
+        static constexpr size_t BUCKET_SIZE = 4;
+
+        struct Entry
+        {
+            uint64_t key = 0;
+            // Proof and disproof numbers for the side to move of the entry.
+            uint32_t phi = 0;
+            uint32_t delta = 0;
+            // Expansions spent below the entry, for replacement.
+            uint32_t work = 0;
+        };
+
+        struct Child
+        {
+            Move move;
+            uint64_t key;
+            // Set for children that end the game; their phi and delta never change.
+            bool terminal;
+            uint32_t phi;
+            uint32_t delta;
+        };
+
+        std::vector<Entry> m_Entries;
+        uint64_t m_BucketMask = 0;
+
+        // Children of every ply on the current path, kept to avoid allocating per expansion.
+        std::vector<std::vector<Child>> m_Children;
+        // Moves a node is limited to when a line is one stone short of a win.
+        std::vector<Move> m_Forced;
+        // Every cell of the grid, center first; shared with every search on the same shape.
+        std::shared_ptr<const std::vector<Move>> m_MoveOrder;
+
+        // Stones on every win line of the solved position, updated by Play and Undo.
+        LineCounts m_LineCounts;
+
+        // State of the running pass: the side trying to prove its goal, and whether a draw reaches it.
+        size_t m_Attacker = 0;
+        bool m_DrawsForAttacker = false;
+        Move m_RootMove = {0, 0};
+
+        SearchLimits m_Limits;
+        ProofStats m_Stats;
+        bool m_Aborted = false;
+        std::chrono::steady_clock::time_point m_StartTime;
+
+    public:
+        // Constructors & Destructors
+        explicit ProofNumberSolver(size_t megabytes = DEFAULT_SIZE_MB);
+
+        // Getters & Setters
+    public:
+        size_t GetEntryCount() const;
+        size_t GetSizeInBytes() const;
+
+        // Public methods
+    public:
+        // Solves position within limits; maxNodes counts expansions and maxDepth is not used. Entries of earlier
+        // solves are kept, so solving again, or after LoadCheckpoint, continues an unfinished proof.
+        // The position is walked with MakeMove/UnmakeMove and is unchanged when the solve returns.
+        ProofResult Solve(Position &position, const SearchLimits &limits = SearchLimits());
+
+        // Writes the table to path; returns false if the file cannot be written.
+        bool SaveCheckpoint(const std::string &path) const;
+        // Replaces the table with the one saved at path, resizing it to match; returns false and keeps the table if
+        // the file is missing or not a checkpoint.
+        bool LoadCheckpoint(const std::string &path);
+
+        void Clear();
+        void Resize(size_t megabytes);
+
+        // Private methods
+    private:
+        // Runs one df-pn pass from the root; returns the root's phi and delta for the side to move.
+        void RunPass(Position &position, uint32_t &phi, uint32_t &delta);
+        // Expands the position until its phi or delta reaches its threshold or the budget runs out, stores them and
+        // returns them.
+        void SearchNode(Position &position, uint64_t key, uint32_t thresholdPhi, uint32_t thresholdDelta, unsigned int ply, uint32_t &phi, uint32_t &delta);
+        // Fills the ply's child list with every legal move, scored from the table or as the end of the game.
+        void GenerateChildren(Position &position, unsigned int ply);
+        // Scores a position whose game is over, or decided because the side that needs a line has none left;
+        // returns false if it is neither.
+        bool ScoreTerminal(const Position &position, uint32_t &phi, uint32_t &delta) const;
+
+        // MakeMove and UnmakeMove that keep the line counts up to date.
+        void Play(Position &position, Move move);
+        void Undo(Position &position);
+
+        uint64_t GetKey(const Position &position) const;
+        bool Probe(uint64_t key, uint32_t &phi, uint32_t &delta);
+        void Store(uint64_t key, uint32_t phi, uint32_t delta, uint64_t work);
+
+        bool IsOutOfBudget() const;
+        double GetElapsedMilliseconds() const;
+    };
+}
\ No newline at end of file
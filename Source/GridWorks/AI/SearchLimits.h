@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace GridWorks
+{
+    // Budget for one engine search; 0 (or null) means no limit.
+    // Engines stop on whichever limit is hit first and answer with the best move found by then.
+    struct SearchLimits
+    {
+        // Plies to search; 0 searches until the board is full.
+        unsigned int maxDepth = 0;
+        // Nodes to search; tree search engines count iterations instead.
+        uint64_t maxNodes = 0;
+        // Wall-clock budget for the whole search.
+        double maxMilliseconds = 0.0;
+        // The search stops as soon as this is set; it is only read.
+        const std::atomic<bool> *stop = nullptr;
+    };
+}
\ No newline at end of file
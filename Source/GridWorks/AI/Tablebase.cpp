@@ -0,0 +1,454 @@
+#include "Tablebase.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include <durlib.h>
+
+#include "Grid/WinLineTable.h"
+
+namespace GridWorks
+{
+    constexpr char TABLEBASE_MAGIC[4] = {'G', 'W', 'T', 'B'};
+    constexpr uint32_t TABLEBASE_VERSION = 1;
+    // Ranks a generator thread claims at a time.
+    constexpr uint64_t GENERATE_CHUNK = 4096;
+
+    struct TablebaseHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t positionCount;
+        unsigned char rows;
+        unsigned char cols;
+        unsigned char winLength;
+        unsigned char reserved[5];
+    };
+
+    static ProofValue GetPackedValue(const uint8_t *values, uint64_t rank)
+    {
+        return static_cast<ProofValue>((values[rank / 4] >> (rank % 4 * 2)) & 3);
+    }
+
+    static uint32_t GetLineMask(const WinLineTable &lines, size_t line)
+    {
+        uint32_t mask = 0;
+        for (uint16_t cell : lines.GetLineCells(line))
+            mask |= 1u << cell;
+        return mask;
+    }
+
+    static bool HasLine(const std::vector<uint32_t> &lineMasks, uint32_t stones)
+    {
+        return std::any_of(lineMasks.begin(), lineMasks.end(), [stones](uint32_t line)
+                           { return (stones & line) == line; });
+    }
+
+    // Constructors & Destructors
+    PositionRank::PositionRank(size_t cellCount)
+        : m_CellCount(cellCount)
+    {
+        if (cellCount > MAX_CELLS)
+        {
+            throw std::invalid_argument("PositionRank supports at most 25 cells");
+        }
+
+        for (size_t n = 0; n <= MAX_CELLS; ++n)
+        {
+            m_Binomials[n][0] = 1;
+            for (size_t k = 1; k <= n; ++k)
+                m_Binomials[n][k] = m_Binomials[n - 1][k - 1] + m_Binomials[n - 1][k];
+        }
+
+        m_PlyStarts.assign(cellCount + 2, 0);
+        for (size_t ply = 0; ply <= cellCount; ++ply)
+        {
+            const size_t firstCount = (ply + 1) / 2;
+            const size_t secondCount = ply / 2;
+            m_PlyStarts[ply + 1] = m_PlyStarts[ply] + m_Binomials[cellCount][firstCount] * m_Binomials[cellCount - firstCount][secondCount];
+        }
+    }
+
+    // Getters & Setters
+
+    size_t PositionRank::GetCellCount() const
+    {
+        return m_CellCount;
+    }
+
+    uint64_t PositionRank::GetPositionCount() const
+    {
+        return m_PlyStarts.back();
+    }
+
+    std::pair<uint64_t, uint64_t> PositionRank::GetPlyRange(size_t ply) const
+    {
+        return {m_PlyStarts[ply], m_PlyStarts[ply + 1]};
+    }
+
+    // Public methods
+
+    uint64_t PositionRank::Rank(uint32_t first, uint32_t second) const
+    {
+        const size_t firstCount = std::popcount(first);
+        const size_t secondCount = std::popcount(second);
+
+        // The second player's cells are numbered among the cells the first player left empty.
+        uint32_t packed = 0;
+        for (uint32_t rest = second; rest != 0; rest &= rest - 1)
+        {
+            const unsigned int cell = std::countr_zero(rest);
+            packed |= 1u << (cell - std::popcount(first & ((1u << cell) - 1)));
+        }
+
+        return m_PlyStarts[firstCount + secondCount] + RankSubset(first) * m_Binomials[m_CellCount - firstCount][secondCount] + RankSubset(packed);
+    }
+
+    void PositionRank::Unrank(uint64_t rank, uint32_t &first, uint32_t &second) const
+    {
+        const size_t ply = std::upper_bound(m_PlyStarts.begin(), m_PlyStarts.end(), rank) - m_PlyStarts.begin() - 1;
+        const size_t firstCount = (ply + 1) / 2;
+        const size_t secondCount = ply / 2;
+        const uint64_t secondRanks = m_Binomials[m_CellCount - firstCount][secondCount];
+        const uint64_t local = rank - m_PlyStarts[ply];
+
+        first = UnrankSubset(local / secondRanks, firstCount);
+        const uint32_t packed = UnrankSubset(local % secondRanks, secondCount);
+        second = 0;
+        size_t index = 0;
+        for (size_t cell = 0; cell < m_CellCount; ++cell)
+        {
+            if (first & (1u << cell))
+                continue;
+            if (packed & (1u << index))
+                second |= 1u << cell;
+            ++index;
+        }
+    }
+
+    // Private methods
+
+    uint64_t PositionRank::RankSubset(uint32_t mask) const
+    {
+        uint64_t rank = 0;
+        size_t index = 1;
+        for (uint32_t rest = mask; rest != 0; rest &= rest - 1)
+            rank += m_Binomials[std::countr_zero(rest)][index++];
+        return rank;
+    }
+
+    uint32_t PositionRank::UnrankSubset(uint64_t rank, size_t count) const
+    {
+        uint32_t mask = 0;
+        for (size_t index = count; index > 0; --index)
+        {
+            // The largest cell whose binomial still fits.
+            size_t cell = index - 1;
+            while (m_Binomials[cell + 1][index] <= rank)
+                ++cell;
+            rank -= m_Binomials[cell][index];
+            mask |= 1u << cell;
+        }
+        return mask;
+    }
+
+    // Getters & Setters
+
+    bool Tablebase::IsOpen() const
+    {
+        return m_File.IsOpen();
+    }
+
+    uint64_t Tablebase::GetPositionCount() const
+    {
+        return m_Rank ? m_Rank->GetPositionCount() : 0;
+    }
+
+    unsigned char Tablebase::GetRows() const
+    {
+        return m_Rows;
+    }
+
+    unsigned char Tablebase::GetCols() const
+    {
+        return m_Cols;
+    }
+
+    unsigned char Tablebase::GetWinLength() const
+    {
+        return m_WinLength;
+    }
+
+    // Public methods
+
+    bool Tablebase::Open(const std::string &path)
+    {
+        Close();
+
+        if (!m_File.Open(path))
+        {
+            CLI_ERROR("Cannot map tablebase {0}.", path);
+            return false;
+        }
+
+        const size_t size = m_File.GetSize();
+        TablebaseHeader header = {};
+        if (size >= sizeof(header))
+            std::memcpy(&header, m_File.GetData(), sizeof(header));
+        const size_t cellCount = static_cast<size_t>(header.rows) * header.cols;
+        if (size < sizeof(header) || std::memcmp(header.magic, TABLEBASE_MAGIC, sizeof(header.magic)) != 0 || header.version != TABLEBASE_VERSION ||
+            cellCount > PositionRank::MAX_CELLS || size != sizeof(header) + (header.positionCount + 3) / 4 ||
+            header.positionCount != PositionRank(cellCount).GetPositionCount())
+        {
+            CLI_ERROR("{0} is not a tablebase.", path);
+            m_File.Close();
+            return false;
+        }
+
+        m_Values = static_cast<const uint8_t *>(m_File.GetData()) + sizeof(header);
+        m_Rows = header.rows;
+        m_Cols = header.cols;
+        m_WinLength = header.winLength;
+        m_Rank = std::make_unique<PositionRank>(cellCount);
+        return true;
+    }
+
+    void Tablebase::Close()
+    {
+        m_File.Close();
+        m_Values = nullptr;
+        m_Rows = 0;
+        m_Cols = 0;
+        m_WinLength = 0;
+        m_Rank.reset();
+    }
+
+    ProofValue Tablebase::GetValue(const Position &position) const
+    {
+        uint32_t first = 0;
+        uint32_t second = 0;
+        if (!GetMasks(position, first, second))
+            return Unproven;
+        return GetValue(m_Rank->Rank(first, second));
+    }
+
+    bool Tablebase::Probe(const Position &position, TablebaseEntry &entry) const
+    {
+        uint32_t stones[2] = {};
+        if (!GetMasks(position, stones[0], stones[1]))
+            return false;
+
+        const WinLineTable &lines = position.GetGrid().GetWinLines();
+        const size_t side = position.GetSideToMove();
+        for (size_t line = 0; line < lines.GetLineCount(); ++line)
+        {
+            const uint32_t mask = GetLineMask(lines, line);
+            if ((stones[side ^ 1] & mask) == mask)
+                return false;
+        }
+
+        entry.value = GetValue(m_Rank->Rank(stones[0], stones[1]));
+        bool found = false;
+        for (size_t cell = 0; cell < m_Rank->GetCellCount(); ++cell)
+        {
+            const uint32_t bit = 1u << cell;
+            if ((stones[0] | stones[1]) & bit)
+                continue;
+
+            stones[side] |= bit;
+            const ProofValue child = GetValue(m_Rank->Rank(stones[0], stones[1]));
+            bool winsNow = false;
+            if (child == ProvenLoss)
+            {
+                auto [row, col] = lines.FromCell(static_cast<uint16_t>(cell));
+                for (uint32_t line : lines.GetLinesThrough(row, col))
+                {
+                    const uint32_t mask = GetLineMask(lines, line);
+                    winsNow |= (stones[side] & mask) == mask;
+                }
+            }
+            stones[side] &= ~bit;
+
+            // The child's value is for the opponent; every move of a lost position keeps the value.
+            const bool keepsValue = (entry.value == ProvenWin && child == ProvenLoss) || (entry.value == ProvenDraw && child == ProvenDraw) ||
+                                    entry.value == ProvenLoss;
+            if (keepsValue && (!found || winsNow))
+            {
+                auto [row, col] = lines.FromCell(static_cast<uint16_t>(cell));
+                entry.bestMove = {row, col};
+                found = true;
+                if (winsNow || entry.value != ProvenWin)
+                    break;
+            }
+        }
+        return found;
+    }
+
+    bool Tablebase::Generate(unsigned char rows, unsigned char cols, unsigned char winLength, const std::string &path, size_t threadCount)
+    {
+        const size_t cellCount = static_cast<size_t>(rows) * cols;
+        if (cellCount > PositionRank::MAX_CELLS)
+        {
+            throw std::invalid_argument("Tablebase grids have at most 25 cells");
+        }
+
+        const PositionRank rank(cellCount);
+        std::shared_ptr<const WinLineTable> lines = WinLineTable::Get(rows, cols, winLength);
+        std::vector<uint32_t> lineMasks;
+        for (size_t line = 0; line < lines->GetLineCount(); ++line)
+            lineMasks.push_back(GetLineMask(*lines, line));
+
+        // Where every cell goes under every symmetry of the grid, Identity first.
+        std::vector<std::vector<uint8_t>> symmetries;
+        for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+        {
+            Symmetry symmetry = static_cast<Symmetry>(i);
+            if (!IsSymmetryValid(symmetry, rows, cols))
+                continue;
+            std::vector<uint8_t> &cells = symmetries.emplace_back(cellCount);
+            for (size_t cell = 0; cell < cellCount; ++cell)
+            {
+                auto [row, col] = ApplySymmetry(symmetry, static_cast<unsigned char>(cell / cols), static_cast<unsigned char>(cell % cols), rows, cols);
+                cells[cell] = static_cast<uint8_t>(row * cols + col);
+            }
+        }
+        auto transform = [](const std::vector<uint8_t> &cells, uint32_t mask)
+        {
+            uint32_t result = 0;
+            for (uint32_t rest = mask; rest != 0; rest &= rest - 1)
+                result |= 1u << cells[std::countr_zero(rest)];
+            return result;
+        };
+
+        // Values are only ever ORed into zeroed slots, and a ply only reads the ply after it, solved before it started.
+        std::vector<std::atomic<uint8_t>> values((rank.GetPositionCount() + 3) / 4);
+        auto getValue = [&](uint64_t position)
+        {
+            return static_cast<ProofValue>((values[position / 4].load(std::memory_order_relaxed) >> (position % 4 * 2)) & 3);
+        };
+
+        auto solve = [&](uint64_t position, size_t ply)
+        {
+            uint32_t stones[2] = {};
+            rank.Unrank(position, stones[0], stones[1]);
+
+            // Only the smallest rank of every symmetric set is solved.
+            uint64_t variants[SYMMETRY_COUNT] = {};
+            for (size_t i = 0; i < symmetries.size(); ++i)
+            {
+                variants[i] = rank.Rank(transform(symmetries[i], stones[0]), transform(symmetries[i], stones[1]));
+                if (variants[i] < position)
+                    return;
+            }
+
+            const size_t side = ply % 2;
+            ProofValue value = ProvenLoss;
+            if (HasLine(lineMasks, stones[side ^ 1]))
+            {
+                value = ProvenLoss;
+            }
+            else if (ply == cellCount)
+            {
+                value = ProvenDraw;
+            }
+            else
+            {
+                const uint32_t empty = ~(stones[0] | stones[1]) & ((1u << cellCount) - 1);
+                for (uint32_t rest = empty; rest != 0; rest &= rest - 1)
+                {
+                    const uint32_t bit = rest & (~rest + 1);
+                    const ProofValue child = side == 0 ? getValue(rank.Rank(stones[0] | bit, stones[1])) : getValue(rank.Rank(stones[0], stones[1] | bit));
+                    if (child == ProvenLoss)
+                    {
+                        value = ProvenWin;
+                        break;
+                    }
+                    if (child == ProvenDraw)
+                        value = ProvenDraw;
+                }
+            }
+
+            for (size_t i = 0; i < symmetries.size(); ++i)
+                values[variants[i] / 4].fetch_or(static_cast<uint8_t>(value << (variants[i] % 4 * 2)), std::memory_order_relaxed);
+        };
+
+        for (size_t ply = cellCount + 1; ply-- > 0;)
+        {
+            auto [begin, end] = rank.GetPlyRange(ply);
+            std::atomic<uint64_t> next{begin};
+            auto worker = [&]()
+            {
+                for (uint64_t chunk = next.fetch_add(GENERATE_CHUNK); chunk < end; chunk = next.fetch_add(GENERATE_CHUNK))
+                {
+                    for (uint64_t position = chunk; position < std::min(end, chunk + GENERATE_CHUNK); ++position)
+                        solve(position, ply);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < threadCount; ++i)
+                threads.emplace_back(worker);
+            worker();
+            for (std::thread &thread : threads)
+                thread.join();
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            CLI_ERROR("Cannot open tablebase {0} for writing.", path);
+            return false;
+        }
+
+        TablebaseHeader header = {};
+        std::memcpy(header.magic, TABLEBASE_MAGIC, sizeof(header.magic));
+        header.version = TABLEBASE_VERSION;
+        header.positionCount = rank.GetPositionCount();
+        header.rows = rows;
+        header.cols = cols;
+        header.winLength = winLength;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        std::vector<uint8_t> packed(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+            packed[i] = values[i].load(std::memory_order_relaxed);
+        file.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(packed.size()));
+        return static_cast<bool>(file);
+    }
+
+    // Private methods
+
+    ProofValue Tablebase::GetValue(uint64_t rank) const
+    {
+        return GetPackedValue(m_Values, rank);
+    }
+
+    bool Tablebase::GetMasks(const Position &position, uint32_t &first, uint32_t &second) const
+    {
+        const Grid &grid = position.GetGrid();
+        if (!m_Rank || position.GetPlayerCount() != 2 || grid.GetRows() != m_Rows || grid.GetCols() != m_Cols || grid.GetWinLength() != m_WinLength)
+            return false;
+
+        first = 0;
+        second = 0;
+        for (unsigned char row = 0; row < m_Rows; ++row)
+        {
+            for (unsigned char col = 0; col < m_Cols; ++col)
+            {
+                const char c = grid.GetCharAt(row, col);
+                if (c == position.GetPlayerChar(0))
+                    first |= 1u << (row * m_Cols + col);
+                else if (c == position.GetPlayerChar(1))
+                    second |= 1u << (row * m_Cols + col);
+            }
+        }
+
+        const int firstCount = std::popcount(first);
+        const int secondCount = std::popcount(second);
+        return (firstCount == secondCount || firstCount == secondCount + 1) && position.GetSideToMove() == static_cast<size_t>(firstCount - secondCount);
+    }
+}
\ No newline at end of file
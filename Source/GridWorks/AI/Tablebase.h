@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AI/MappedFile.h"
+#include "AI/Position.h"
+#include "AI/ProofNumberSolver.h"
+
+namespace GridWorks
+{
+    // Perfect rank of the two-player positions of a grid with the first player moving first: every placement of
+    // the stones of both sides with the first one stone ahead or level gets its own index in [0, GetPositionCount).
+    // Positions are ranked by ply, then by the cells of the first player among all cells, then by the cells of the
+    // second player among the cells left, both in combinatorial (colex) order. Sides are bitmasks of cell indexes.
+    class PositionRank
+    {
+    public:
+        // Cells are bits of a 32-bit mask.
+        static constexpr size_t MAX_CELLS = 25;
+
+    private:
+        size_t m_CellCount;
+        // m_Binomials[n][k] is n choose k.
+        uint64_t m_Binomials[MAX_CELLS + 1][MAX_CELLS + 1] = {};
+        // First rank of every ply, plus the position count at the end.
+        std::vector<uint64_t> m_PlyStarts;
+
+    public:
+        // Constructors & Destructors
+        explicit PositionRank(size_t cellCount);
+
+        // Getters & Setters
+    public:
+        size_t GetCellCount() const;
+        uint64_t GetPositionCount() const;
+        // Range [first, last) of the ranks of positions with ply stones.
+        std::pair<uint64_t, uint64_t> GetPlyRange(size_t ply) const;
+
+        // Public methods
+    public:
+        uint64_t Rank(uint32_t first, uint32_t second) const;
+        void Unrank(uint64_t rank, uint32_t &first, uint32_t &second) const;
+
+        // Private methods
+    private:
+        uint64_t RankSubset(uint32_t mask) const;
+        uint32_t UnrankSubset(uint64_t rank, size_t count) const;
+    };
+
+    struct TablebaseEntry
+    {
+        ProofValue value = Unproven;
+        // A move that keeps the value: one that wins on the spot when there is one.
+        Move bestMove = {0, 0};
+    };
+
+    // Endgame tablebase: the value of every position of a small grid for the side to move, two bits per position
+    // (as a ProofValue) indexed by PositionRank, solved once by retrograde analysis and memory-mapped for lookups.
+    // A tablebase is built for one grid shape and win length, with the first player in the turn order moving first.
+    // Distances are not stored: every move fills a cell, so always picking a move that keeps the value still ends
+    // the game with that value.
+    class Tablebase
+    {
+    private:
+        MappedFile m_File;
+        const uint8_t *m_Values = nullptr;
+        unsigned char m_Rows = 0;
+        unsigned char m_Cols = 0;
+        unsigned char m_WinLength = 0;
+        std::unique_ptr<PositionRank> m_Rank;
+
+    public:
+        // Constructors & Destructors
+        Tablebase() = default;
+
+        // Getters & Setters
+    public:
+        bool IsOpen() const;
+        uint64_t GetPositionCount() const;
+        unsigned char GetRows() const;
+        unsigned char GetCols() const;
+        unsigned char GetWinLength() const;
+
+        // Public methods
+    public:
+        // Maps the tablebase at path, closing the open one; returns false and stays closed if the file is missing or
+        // not a tablebase.
+        bool Open(const std::string &path);
+        void Close();
+
+        // Value of position for the side to move; Unproven if the tablebase is for another grid, or the position does
+        // not have two players that took turns from the first.
+        ProofValue GetValue(const Position &position) const;
+        // Value and a move that keeps it; returns false where GetValue is Unproven or the game is over.
+        bool Probe(const Position &position, TablebaseEntry &entry) const;
+
+        // Solves every position of the grid by retrograde analysis, one ply at a time from the full grid back to the
+        // empty one, with threadCount threads sharing each ply. Only one position of every set of symmetric ones is
+        // solved and its value written for all of them. Writes the table to path; returns false if the file cannot be
+        // written, and throws std::invalid_argument for grids of more than PositionRank::MAX_CELLS cells.
+        static bool Generate(unsigned char rows, unsigned char cols, unsigned char winLength, const std::string &path, size_t threadCount = 1);
+
+        // Private methods
+    private:
+        ProofValue GetValue(uint64_t rank) const;
+        // Stones of both sides as masks; returns false if the position is not in the table.
+        bool GetMasks(const Position &position, uint32_t &first, uint32_t &second) const;
+    };
+}
\ No newline at end of file
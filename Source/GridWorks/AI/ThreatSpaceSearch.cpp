@@ -0,0 +1,348 @@
+#include "ThreatSpaceSearch.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include <durlib.h>
+
+namespace GridWorks
+{
+    static void AddUnique(std::vector<Move> &moves, Move move)
+    {
+        if (std::find(moves.begin(), moves.end(), move) == moves.end())
+            moves.push_back(move);
+    }
+
+    // Constructors & Destructors
+    ThreatSpaceSearch::ThreatSpaceSearch(ThreatSearchMode mode)
+        : m_Mode(mode)
+    {
+    }
+
+    // Getters & Setters
+
+    ThreatSearchMode ThreatSpaceSearch::GetMode() const
+    {
+        return m_Mode;
+    }
+
+    void ThreatSpaceSearch::SetMode(ThreatSearchMode mode)
+    {
+        m_Mode = mode;
+    }
+
+    // Public methods
+
+    ThreatResult ThreatSpaceSearch::Search(Position &position, const SearchLimits &limits)
+    {
+        if (position.GetPlayerCount() != 2)
+        {
+            throw std::invalid_argument("ThreatSpaceSearch only supports two players");
+        }
+
+        m_Limits = limits;
+        m_Stats = ThreatStats();
+        m_Aborted = false;
+        m_StartTime = std::chrono::steady_clock::now();
+        m_Attacker = position.GetSideToMove();
+        m_LineCounts.Reset(position);
+        m_Refuted.clear();
+
+        ThreatResult result;
+        const unsigned int maxThreats = limits.maxDepth == 0 ? DEFAULT_MAX_THREATS : limits.maxDepth;
+        for (unsigned int threats = 1; threats <= maxThreats; ++threats)
+        {
+            std::vector<Move> sequence;
+            if (Attack(position, threats, sequence))
+            {
+                result.found = true;
+                result.sequence = std::move(sequence);
+                m_Stats.depth = threats;
+                break;
+            }
+            if (m_Aborted)
+                break;
+            m_Stats.depth = threats;
+        }
+
+        result.stats = m_Stats;
+        result.stats.elapsedMilliseconds = GetElapsedMilliseconds();
+        return result;
+    }
+
+    // Private methods
+
+    bool ThreatSpaceSearch::Attack(Position &position, unsigned int threatsLeft, std::vector<Move> &sequence)
+    {
+        ++m_Stats.nodes;
+        if (m_Aborted || IsOutOfBudget())
+        {
+            m_Aborted = true;
+            return false;
+        }
+
+        const size_t defender = m_Attacker ^ 1;
+        std::vector<Move> wins;
+        FindWinningCells(position, m_Attacker, wins);
+        if (!wins.empty())
+        {
+            sequence.assign(1, wins.front());
+            return true;
+        }
+
+        // A four of the defender has to be blocked, and two cannot be.
+        std::vector<Move> defenderWins;
+        FindWinningCells(position, defender, defenderWins);
+        if (defenderWins.size() >= 2 || threatsLeft == 0)
+            return false;
+
+        const uint64_t hash = position.GetHash();
+        auto refuted = m_Refuted.find(hash);
+        if (refuted != m_Refuted.end() && refuted->second >= threatsLeft)
+            return false;
+
+        // Fours first: they leave the defender a single reply.
+        std::vector<Move> threats;
+        if (!defenderWins.empty())
+        {
+            // The block has to be a threat itself, which Defend checks.
+            threats = defenderWins;
+        }
+        else
+        {
+            FindFours(position, m_Attacker, threats);
+            if (m_Mode == FoursAndThrees)
+                FindThrees(position, threats);
+        }
+
+        for (const Move &threat : threats)
+        {
+            std::vector<Move> line;
+            Play(position, threat);
+            bool won = Defend(position, threatsLeft - 1, line);
+            Undo(position);
+            if (won)
+            {
+                sequence.assign(1, threat);
+                sequence.insert(sequence.end(), line.begin(), line.end());
+                return true;
+            }
+            if (m_Aborted)
+                return false;
+        }
+
+        unsigned int &refutedThreats = m_Refuted[hash];
+        refutedThreats = std::max(refutedThreats, threatsLeft);
+        return false;
+    }
+
+    bool ThreatSpaceSearch::Defend(Position &position, unsigned int threatsLeft, std::vector<Move> &sequence)
+    {
+        ++m_Stats.nodes;
+        const size_t defender = m_Attacker ^ 1;
+        std::vector<Move> cells;
+        FindWinningCells(position, defender, cells);
+        if (!cells.empty())
+            return false;
+
+        std::vector<Move> replies;
+        FindWinningCells(position, m_Attacker, cells);
+        if (cells.size() >= 2)
+        {
+            // Block one, lose on the other.
+            sequence = {cells[0], cells[1]};
+            return true;
+        }
+        if (cells.size() == 1)
+        {
+            replies = cells;
+        }
+        else if (m_Mode == FoursAndThrees && HasDoubleFour(position))
+        {
+            // A three is stopped by a stone that leaves the attacker no double four, or answered with a four.
+            std::vector<Move> candidates;
+            FindCellsOnLines(position, m_Attacker, 2, candidates);
+            for (const Move &candidate : candidates)
+            {
+                Play(position, candidate);
+                if (!HasDoubleFour(position))
+                    replies.push_back(candidate);
+                Undo(position);
+            }
+            std::vector<Move> counterFours;
+            FindFours(position, defender, counterFours);
+            for (const Move &counterFour : counterFours)
+                AddUnique(replies, counterFour);
+        }
+        else
+        {
+            // Not a threat.
+            return false;
+        }
+
+        sequence.clear();
+        for (const Move &reply : replies)
+        {
+            std::vector<Move> line;
+            Play(position, reply);
+            bool won = Attack(position, threatsLeft, line);
+            Undo(position);
+            if (!won)
+                return false;
+            if (sequence.empty())
+            {
+                sequence.assign(1, reply);
+                sequence.insert(sequence.end(), line.begin(), line.end());
+            }
+        }
+        return true;
+    }
+
+    void ThreatSpaceSearch::FindWinningCells(const Position &position, size_t side, std::vector<Move> &cells) const
+    {
+        FindCellsOnLines(position, side, 1, cells);
+    }
+
+    void ThreatSpaceSearch::FindCellsOnLines(const Position &position, size_t side, unsigned int missing, std::vector<Move> &cells) const
+    {
+        cells.clear();
+        const unsigned char winLength = position.GetGrid().GetWinLength();
+        if (missing > winLength)
+            return;
+
+        const WinLineTable &lines = m_LineCounts.GetLines();
+        const size_t count = winLength - missing;
+        for (size_t line = 0; line < m_LineCounts.GetLineCount(); ++line)
+        {
+            if (m_LineCounts.GetCount(side, line) != count || m_LineCounts.GetCount(side ^ 1, line) != 0)
+                continue;
+            if (m_LineCounts.HasPatterns())
+            {
+                AddEmptyCells(line, m_LineCounts.GetPattern(line).emptyMask, cells);
+                continue;
+            }
+            for (uint16_t cell : lines.GetLineCells(line))
+            {
+                auto [row, col] = lines.FromCell(cell);
+                if (position.IsLegalMove(row, col))
+                    AddUnique(cells, Move{row, col});
+            }
+        }
+    }
+
+    void ThreatSpaceSearch::FindFours(const Position &position, size_t side, std::vector<Move> &moves) const
+    {
+        // Any stone on a line two short of the win leaves it one short with the last cell empty.
+        FindCellsOnLines(position, side, 2, moves);
+    }
+
+    void ThreatSpaceSearch::FindThrees(Position &position, std::vector<Move> &moves)
+    {
+        // A three adds a stone to a line three short of the win; fours are already in moves.
+        std::vector<Move> candidates;
+        FindCellsOnLines(position, m_Attacker, 3, candidates);
+        for (const Move &candidate : candidates)
+        {
+            if (std::find(moves.begin(), moves.end(), candidate) != moves.end())
+                continue;
+            Play(position, candidate);
+            bool three = HasDoubleFour(position);
+            Undo(position);
+            if (three)
+                moves.push_back(candidate);
+        }
+    }
+
+    bool ThreatSpaceSearch::HasDoubleFour(Position &position)
+    {
+        // The follow-up stone is only added to the line counts, so it works whoever is to move.
+        std::vector<Move> candidates;
+        FindCellsOnLines(position, m_Attacker, 2, candidates);
+        for (const Move &candidate : candidates)
+        {
+            m_LineCounts.Add(m_Attacker, candidate);
+            size_t winningCells = CountWinningCellsThrough(position, m_Attacker, candidate);
+            m_LineCounts.Remove(m_Attacker, candidate);
+            if (winningCells >= 2)
+                return true;
+        }
+        return false;
+    }
+
+    size_t ThreatSpaceSearch::CountWinningCellsThrough(const Position &position, size_t side, Move move) const
+    {
+        const WinLineTable &lines = m_LineCounts.GetLines();
+        const unsigned char winLength = position.GetGrid().GetWinLength();
+        Move first = move;
+        for (uint32_t line : lines.GetLinesThrough(move.row, move.col))
+        {
+            if (m_LineCounts.GetCount(side, line) + 1 != winLength || m_LineCounts.GetCount(side ^ 1, line) != 0)
+                continue;
+            if (m_LineCounts.HasPatterns())
+            {
+                // move is in the pattern already, so the one empty cell left is the winning one.
+                const PatternEntry &pattern = m_LineCounts.GetPattern(line);
+                Move winning = ToMove(line, static_cast<size_t>(std::countr_zero(pattern.emptyMask)));
+                if (first == move)
+                    first = winning;
+                else if (!(winning == first))
+                    return 2;
+                continue;
+            }
+            for (uint16_t cell : lines.GetLineCells(line))
+            {
+                auto [row, col] = lines.FromCell(cell);
+                Move winning = {row, col};
+                // move is only in the line counts, so the grid still shows it empty.
+                if (winning == move || !position.IsLegalMove(row, col))
+                    continue;
+                if (first == move)
+                    first = winning;
+                else if (!(winning == first))
+                    return 2;
+            }
+        }
+        return first == move ? 0 : 1;
+    }
+
+    void ThreatSpaceSearch::AddEmptyCells(size_t line, uint16_t emptyMask, std::vector<Move> &cells) const
+    {
+        for (uint16_t mask = emptyMask; mask != 0; mask &= mask - 1)
+            AddUnique(cells, ToMove(line, static_cast<size_t>(std::countr_zero(mask))));
+    }
+
+    Move ThreatSpaceSearch::ToMove(size_t line, size_t position) const
+    {
+        const WinLineTable &lines = m_LineCounts.GetLines();
+        auto [row, col] = lines.FromCell(lines.GetLineCells(line)[position]);
+        return Move{row, col};
+    }
+
+    void ThreatSpaceSearch::Play(Position &position, Move move)
+    {
+        m_LineCounts.Add(position.GetSideToMove(), move);
+        position.MakeMove(move);
+    }
+
+    void ThreatSpaceSearch::Undo(Position &position)
+    {
+        const Move move = position.GetLastMove();
+        position.UnmakeMove();
+        m_LineCounts.Remove(position.GetSideToMove(), move);
+    }
+
+    bool ThreatSpaceSearch::IsOutOfBudget() const
+    {
+        if (m_Limits.maxNodes != 0 && m_Stats.nodes >= m_Limits.maxNodes)
+            return true;
+        if (m_Limits.stop != nullptr && m_Limits.stop->load(std::memory_order_relaxed))
+            return true;
+        return m_Limits.maxMilliseconds > 0.0 && GetElapsedMilliseconds() >= m_Limits.maxMilliseconds;
+    }
+
+    double ThreatSpaceSearch::GetElapsedMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime).count();
+    }
+}
\ No newline at end of file
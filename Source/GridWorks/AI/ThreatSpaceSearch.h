@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "AI/LineCounts.h"
+#include "AI/Position.h"
+#include "AI/SearchLimits.h"
+
+namespace GridWorks
+{
+    // Which threats the attacker may use.
+    enum ThreatSearchMode
+    {
+        // Only fours, moves that threaten to win at once. Every reply is forced, so a sequence found is a proof.
+        FoursOnly = 0,
+        // Fours and threes, moves that threaten to make an unstoppable four. Replies to a three are the moves that
+        // stop it plus the defender's own fours; a sequence found is a win unless the defender can break it with
+        // a quiet move followed by fours.
+        FoursAndThrees = 1
+    };
+
+    struct ThreatStats
+    {
+        // Positions visited, attacker and defender.
+        uint64_t nodes = 0;
+        // Most attacker threats the last completed iteration allowed.
+        unsigned int depth = 0;
+        double elapsedMilliseconds = 0.0;
+
+        double GetNodesPerSecond() const
+        {
+            return elapsedMilliseconds > 0.0 ? nodes * 1000.0 / elapsedMilliseconds : 0.0;
+        }
+    };
+
+    struct ThreatResult
+    {
+        bool found = false;
+        // The winning line for the side to move, starting with its first threat: attacker moves and, where the
+        // defender has a choice, its first reply, ending with the winning move.
+        std::vector<Move> sequence;
+        ThreatStats stats;
+    };
+
+    // Threat-space search: looks for a forced win of the side to move made only of threats and the replies they
+    // force, which keeps the branching to a handful of moves on boards with hundreds of empty cells.
+    // A four is a line one stone short of the win with the last cell empty; a three is a move after which one more
+    // stone makes two fours at once. Threats are found from the stone counts of every win line, and their cells from
+    // the line patterns where the win length has a PatternTable.
+    // Searches deepen one threat at a time, so the shortest sequence is found first, and positions already refuted
+    // with as many threats left are skipped.
+    class ThreatSpaceSearch
+    {
+    public:
+        // Threats per sequence when the limits do not set maxDepth.
+        static constexpr unsigned int DEFAULT_MAX_THREATS = 8;
+
+    private:
+        ThreatSearchMode m_Mode;
+        LineCounts m_LineCounts;
+        size_t m_Attacker = 0;
+        // Most threats left with which an attacker position was refuted, by position hash.
+        std::unordered_map<uint64_t, unsigned int> m_Refuted;
+
+        SearchLimits m_Limits;
+        ThreatStats m_Stats;
+        bool m_Aborted = false;
+        std::chrono::steady_clock::time_point m_StartTime;
+
+    public:
+        // Constructors & Destructors
+        explicit ThreatSpaceSearch(ThreatSearchMode mode = FoursAndThrees);
+
+        // Getters & Setters
+    public:
+        ThreatSearchMode GetMode() const;
+        void SetMode(ThreatSearchMode mode);
+
+        // Public methods
+    public:
+        // Looks for a forced win of the side to move within limits; maxDepth caps the attacker's threats.
+        // The position is walked with MakeMove/UnmakeMove and is unchanged when the search returns.
+        ThreatResult Search(Position &position, const SearchLimits &limits = SearchLimits());
+
+        // Private methods
+    private:
+        // Attacker to move; true if it wins with at most threatsLeft more threats, with the line in sequence.
+        bool Attack(Position &position, unsigned int threatsLeft, std::vector<Move> &sequence);
+        // Defender to move after a threat; true if every reply still loses.
+        bool Defend(Position &position, unsigned int threatsLeft, std::vector<Move> &sequence);
+
+        // Empty cells that complete a line of side.
+        void FindWinningCells(const Position &position, size_t side, std::vector<Move> &cells) const;
+        // Empty cells on lines where side has stones short of a win by missing, and none of the other side.
+        void FindCellsOnLines(const Position &position, size_t side, unsigned int missing, std::vector<Move> &cells) const;
+        // Fours of side: moves after which it has a winning cell.
+        void FindFours(const Position &position, size_t side, std::vector<Move> &moves) const;
+        // Threes of the attacker: moves after which it has a move that makes two fours.
+        void FindThrees(Position &position, std::vector<Move> &moves);
+        // Whether the attacker, to move or not, has a move that leaves it two winning cells.
+        bool HasDoubleFour(Position &position);
+        // Winning cells of side through the cell of its last move.
+        size_t CountWinningCellsThrough(const Position &position, size_t side, Move move) const;
+        // Adds the cells of line set in emptyMask, a pattern's empty cells, to cells.
+        void AddEmptyCells(size_t line, uint16_t emptyMask, std::vector<Move> &cells) const;
+        Move ToMove(size_t line, size_t position) const;
+
+        void Play(Position &position, Move move);
+        void Undo(Position &position);
+        bool IsOutOfBudget() const;
+        double GetElapsedMilliseconds() const;
+    };
+}
\ No newline at end of file
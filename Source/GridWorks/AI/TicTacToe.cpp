@@ -0,0 +1,41 @@
+#include "TicTacToe.h"
+
+namespace GridWorks
+{
+    namespace TicTacToe
+    {
+        bool GetIndex(const Position &position, uint16_t &index)
+        {
+            const Grid &grid = position.GetGrid();
+            if (position.GetPlayerCount() != 2 || grid.GetRows() != 3 || grid.GetCols() != 3 || grid.GetWinLength() != 3)
+                return false;
+
+            index = 0;
+            int stones[2] = {};
+            for (unsigned char cell = 0; cell < CELL_COUNT; ++cell)
+            {
+                const char c = grid.GetCharAt(cell / 3, cell % 3);
+                for (size_t side = 0; side < 2; ++side)
+                {
+                    if (c == position.GetPlayerChar(side))
+                    {
+                        index = static_cast<uint16_t>(index + (side + 1) * POWERS_OF_THREE[cell]);
+                        ++stones[side];
+                    }
+                }
+            }
+            return (stones[0] == stones[1] || stones[0] == stones[1] + 1) && position.GetSideToMove() == static_cast<size_t>(stones[0] - stones[1]);
+        }
+
+        bool Probe(const Position &position, TablebaseEntry &entry)
+        {
+            uint16_t index = 0;
+            if (!GetIndex(position, index) || TABLE.entries[index] == 0 || TABLE.entries[index] >> 2 == NO_CELL)
+                return false;
+
+            entry.value = GetValue(index);
+            entry.bestMove = GetBestMove(index);
+            return true;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "AI/Position.h"
+#include "AI/Tablebase.h"
+
+namespace GridWorks
+{
+    // Perfect play on the classic 3x3 grid with three in a row, solved by a constexpr minimax while the library
+    // compiles: the value and best move of any position are one array load, with no initialization and no file.
+    // Positions are indexed in base 3, cell row * 3 + col being the digit of weight 3^cell: 0 for an empty cell, 1 for
+    // the first player and 2 for the second. The first player moves first.
+    namespace TicTacToe
+    {
+        constexpr size_t CELL_COUNT = 9;
+        constexpr size_t INDEX_COUNT = 19683;
+        constexpr uint16_t LINES[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124};
+        constexpr uint16_t POWERS_OF_THREE[CELL_COUNT] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+        // Best cell of a finished game.
+        constexpr uint8_t NO_CELL = 15;
+
+        // Entries pack the ProofValue for the side to move in the low 2 bits and the best cell above them;
+        // positions the game cannot reach are 0.
+        struct Table
+        {
+            std::array<uint8_t, INDEX_COUNT> entries{};
+            // Positions reached from the empty grid, finished games included.
+            size_t reachable = 0;
+        };
+
+        constexpr bool HasLine(uint16_t stones)
+        {
+            for (uint16_t line : LINES)
+            {
+                if ((stones & line) == line)
+                    return true;
+            }
+            return false;
+        }
+
+        // Minimax from the position with the stones of both sides as masks, memoized in table.
+        constexpr uint8_t Solve(Table &table, uint16_t first, uint16_t second, uint16_t index)
+        {
+            if (table.entries[index] != 0)
+                return table.entries[index];
+            ++table.reachable;
+
+            const size_t side = std::popcount(first) > std::popcount(second) ? 1 : 0;
+            // The side that just moved may have won.
+            const bool lost = HasLine(side == 0 ? second : first);
+            uint8_t entry = ProvenLoss | NO_CELL << 2;
+            if (!lost && (first | second) == 0777)
+            {
+                entry = ProvenDraw | NO_CELL << 2;
+            }
+            else if (!lost)
+            {
+                // Wins beat draws beat losses; of the wins, one on the spot comes first.
+                int best = -2;
+                for (uint8_t cell = 0; cell < CELL_COUNT; ++cell)
+                {
+                    const uint16_t bit = static_cast<uint16_t>(1u << cell);
+                    if ((first | second) & bit)
+                        continue;
+
+                    const uint16_t nextFirst = side == 0 ? first | bit : first;
+                    const uint16_t nextSecond = side == 1 ? second | bit : second;
+                    const uint8_t child = Solve(table, nextFirst, nextSecond, static_cast<uint16_t>(index + (side + 1) * POWERS_OF_THREE[cell]));
+                    const ProofValue childValue = static_cast<ProofValue>(child & 3);
+                    int score = childValue == ProvenLoss ? 1 : childValue == ProvenDraw ? 0 : -1;
+                    if (score == 1 && HasLine(side == 0 ? nextFirst : nextSecond))
+                        score = 2;
+                    if (score > best)
+                    {
+                        best = score;
+                        entry = static_cast<uint8_t>((score >= 1 ? ProvenWin : score == 0 ? ProvenDraw : ProvenLoss) | cell << 2);
+                    }
+                }
+            }
+
+            table.entries[index] = entry;
+            return entry;
+        }
+
+        constexpr Table BuildTable()
+        {
+            Table table;
+            Solve(table, 0, 0, 0);
+            return table;
+        }
+
+        inline constexpr Table TABLE = BuildTable();
+
+        static_assert(TABLE.reachable == 5478, "the 3x3 game has 5478 reachable positions");
+        static_assert((TABLE.entries[0] & 3) == ProvenDraw, "the 3x3 game is a draw");
+        // X X . / O O . / . . . with X to move: X wins at the top right.
+        static_assert(TABLE.entries[1 + 3 + 2 * 27 + 2 * 81] == (ProvenWin | 2 << 2));
+        // X . . / . . . / . . . with O to move: only the center draws.
+        static_assert(TABLE.entries[1] == (ProvenDraw | 4 << 2));
+
+        constexpr ProofValue GetValue(uint16_t index)
+        {
+            return static_cast<ProofValue>(TABLE.entries[index] & 3);
+        }
+
+        constexpr Move GetBestMove(uint16_t index)
+        {
+            const unsigned char cell = static_cast<unsigned char>(TABLE.entries[index] >> 2);
+            return {static_cast<unsigned char>(cell / 3), static_cast<unsigned char>(cell % 3)};
+        }
+
+        // Index of position; returns false if it is not on a 3x3 grid with three in a row, or does not have two
+        // players that took turns from the first.
+        bool GetIndex(const Position &position, uint16_t &index);
+        // Value and best move of position; returns false where GetIndex does, for positions the game cannot reach,
+        // and for finished games.
+        bool Probe(const Position &position, TablebaseEntry &entry);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "TranspositionTable.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "Grid/Zobrist.h"
+
+namespace GridWorks
+{
+    // Layout of a packed entry, low bits first: score (32), depth + 1 (8), bound (2), generation (6), move row (8),
+    // move col (8). Depth is stored plus one so an empty slot, which is all zeroes, never verifies.
+    constexpr unsigned int DEPTH_SHIFT = 32;
+    constexpr unsigned int BOUND_SHIFT = 40;
+    constexpr unsigned int GENERATION_SHIFT = 42;
+    constexpr unsigned int ROW_SHIFT = 48;
+    constexpr unsigned int COL_SHIFT = 56;
+    constexpr uint8_t GENERATION_MASK = 0x3F;
+    constexpr unsigned int MAX_DEPTH = 254;
+    // Buckets looked at by GetFillRate.
+    constexpr size_t FILL_SAMPLE = 1000;
+
+    // Constructors & Destructors
+    TranspositionTable::TranspositionTable(size_t megabytes)
+    {
+        Resize(megabytes);
+    }
+
+    // Getters & Setters
+
+    size_t TranspositionTable::GetEntryCount() const
+    {
+        return m_Buckets.size() * BUCKET_SIZE;
+    }
+
+    size_t TranspositionTable::GetSizeInBytes() const
+    {
+        return m_Buckets.size() * sizeof(Bucket);
+    }
+
+    TranspositionStats TranspositionTable::GetStats() const
+    {
+        TranspositionStats stats;
+        for (const Counters &counters : m_Counters)
+        {
+            stats.probes += counters.probes.load(std::memory_order_relaxed);
+            stats.hits += counters.hits.load(std::memory_order_relaxed);
+            stats.stores += counters.stores.load(std::memory_order_relaxed);
+            stats.collisions += counters.collisions.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    double TranspositionTable::GetFillRate() const
+    {
+        uint8_t generation = m_Generation.load(std::memory_order_relaxed);
+        size_t sample = std::min(FILL_SAMPLE, m_Buckets.size());
+        size_t used = 0;
+        for (size_t bucket = 0; bucket < sample; ++bucket)
+        {
+            for (const Slot &slot : m_Buckets[bucket].slots)
+            {
+                uint64_t data = slot.data.load(std::memory_order_relaxed);
+                used += data != 0 && GetGeneration(data) == generation;
+            }
+        }
+        return static_cast<double>(used) / (sample * BUCKET_SIZE);
+    }
+
+    // Public methods
+
+    uint64_t TranspositionTable::GetKey(const Position &position)
+    {
+        const Grid &grid = position.GetGrid();
+        return position.GetHash() ^ Zobrist::GetShapeKey(grid.GetRows(), grid.GetCols(), grid.GetWinLength());
+    }
+
+    bool TranspositionTable::Probe(uint64_t hash, TranspositionEntry &entry)
+    {
+        Counters &counters = GetThreadCounters();
+        counters.probes.fetch_add(1, std::memory_order_relaxed);
+        Bucket &bucket = m_Buckets[hash & m_IndexMask];
+        for (Slot &slot : bucket.slots)
+        {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            uint64_t key = slot.key.load(std::memory_order_relaxed);
+            if (data != 0 && (key ^ data) == hash)
+            {
+                entry = Unpack(data);
+                counters.hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TranspositionTable::Store(uint64_t hash, const TranspositionEntry &entry)
+    {
+        Counters &counters = GetThreadCounters();
+        counters.stores.fetch_add(1, std::memory_order_relaxed);
+        uint8_t generation = m_Generation.load(std::memory_order_relaxed);
+        Bucket &bucket = m_Buckets[hash & m_IndexMask];
+
+        Slot *target = nullptr;
+        int targetWorth = 0;
+        for (Slot &slot : bucket.slots)
+        {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            uint64_t key = slot.key.load(std::memory_order_relaxed);
+            if (data != 0 && (key ^ data) == hash)
+            {
+                // Same position: keep a deeper result from this search unless the new one is exact.
+                if (entry.bound != ExactBound && GetGeneration(data) == generation && entry.depth < GetDepth(data))
+                    return;
+                target = &slot;
+                break;
+            }
+
+            // Empty slots go first; entries lose 8 plies of worth for every search they are old.
+            int age = (generation - GetGeneration(data)) & GENERATION_MASK;
+            int worth = data == 0 ? INT_MIN : GetDepth(data) - 8 * age;
+            if (target == nullptr || worth < targetWorth)
+            {
+                target = &slot;
+                targetWorth = worth;
+            }
+        }
+
+        uint64_t previous = target->data.load(std::memory_order_relaxed);
+        if (previous != 0 && (target->key.load(std::memory_order_relaxed) ^ previous) != hash)
+            counters.collisions.fetch_add(1, std::memory_order_relaxed);
+        uint64_t data = Pack(entry, generation);
+        target->key.store(hash ^ data, std::memory_order_relaxed);
+        target->data.store(data, std::memory_order_relaxed);
+    }
+
+    void TranspositionTable::NewSearch()
+    {
+        m_Generation.store((m_Generation.load(std::memory_order_relaxed) + 1) & GENERATION_MASK, std::memory_order_relaxed);
+    }
+
+    void TranspositionTable::Clear()
+    {
+        for (Bucket &bucket : m_Buckets)
+        {
+            for (Slot &slot : bucket.slots)
+            {
+                slot.key.store(0, std::memory_order_relaxed);
+                slot.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        m_Generation.store(0, std::memory_order_relaxed);
+        for (Counters &counters : m_Counters)
+        {
+            counters.probes.store(0, std::memory_order_relaxed);
+            counters.hits.store(0, std::memory_order_relaxed);
+            counters.stores.store(0, std::memory_order_relaxed);
+            counters.collisions.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void TranspositionTable::Resize(size_t megabytes)
+    {
+        size_t bucketCount = 1;
+        while (bucketCount * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+            bucketCount *= 2;
+
+        m_Buckets = std::vector<Bucket>(bucketCount);
+        m_IndexMask = bucketCount - 1;
+        Clear();
+    }
+
+    // Private methods
+
+    TranspositionTable::Counters &TranspositionTable::GetThreadCounters()
+    {
+        // Threads get stripes round robin, the same one for every table.
+        static std::atomic<size_t> nextStripe{0};
+        thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % COUNTER_STRIPES;
+        return m_Counters[stripe];
+    }
+
+    uint64_t TranspositionTable::Pack(const TranspositionEntry &entry, uint8_t generation)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(entry.score)) |
+               static_cast<uint64_t>(std::min<unsigned int>(entry.depth, MAX_DEPTH) + 1) << DEPTH_SHIFT |
+               static_cast<uint64_t>(entry.bound) << BOUND_SHIFT |
+               static_cast<uint64_t>(generation) << GENERATION_SHIFT |
+               static_cast<uint64_t>(entry.move.row) << ROW_SHIFT |
+               static_cast<uint64_t>(entry.move.col) << COL_SHIFT;
+    }
+
+    TranspositionEntry TranspositionTable::Unpack(uint64_t data)
+    {
+        TranspositionEntry entry;
+        entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+        entry.depth = GetDepth(data);
+        entry.bound = static_cast<BoundType>((data >> BOUND_SHIFT) & 0x3);
+        entry.move = Move{static_cast<unsigned char>(data >> ROW_SHIFT), static_cast<unsigned char>(data >> COL_SHIFT)};
+        return entry;
+    }
+
+    uint8_t TranspositionTable::GetGeneration(uint64_t data)
+    {
+        return static_cast<uint8_t>((data >> GENERATION_SHIFT) & GENERATION_MASK);
+    }
+
+    unsigned char TranspositionTable::GetDepth(uint64_t data)
+    {
+        return static_cast<unsigned char>(((data >> DEPTH_SHIFT) & 0xFF) - 1);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "AI/Position.h"
+
+namespace GridWorks
+{
+    // What a stored score says about the real value of the position.
+    enum BoundType
+    {
+        NoBound = 0,
+        // The score is exact.
+        ExactBound = 1,
+        // The search failed high; the real value is at least the score.
+        LowerBound = 2,
+        // The search failed low; the real value is at most the score.
+        UpperBound = 3
+    };
+
+    struct TranspositionEntry
+    {
+        int score = 0;
+        unsigned char depth = 0;
+        BoundType bound = NoBound;
+        // {NO_MOVE, NO_MOVE} when the search had no best move to store.
+        Move move = {255, 255};
+    };
+
+    struct TranspositionStats
+    {
+        uint64_t probes = 0;
+        uint64_t hits = 0;
+        uint64_t stores = 0;
+        // Stores that evicted an entry of a different position.
+        uint64_t collisions = 0;
+
+        double GetHitRate() const
+        {
+            return probes > 0 ? static_cast<double>(hits) / probes : 0.0;
+        }
+
+        double GetCollisionRate() const
+        {
+            return stores > 0 ? static_cast<double>(collisions) / stores : 0.0;
+        }
+    };
+
+    // Fixed-size hash table of search results keyed by GetKey, the position hash mixed with the grid shape.
+    // Lockless: every slot holds the packed entry and the key XOR the entry in two atomic words, so a slot torn by
+    // a concurrent store fails verification and reads as a miss. Any number of threads and games may share a table.
+    // Slots are grouped four to a cache line; a store replaces the shallowest entry of its bucket, treating entries
+    // from older searches as shallower.
+    class TranspositionTable
+    {
+    public:
+        static constexpr unsigned char NO_MOVE = 255;
+        static constexpr size_t DEFAULT_SIZE_MB = 16;
+
+    private:
+        static constexpr size_t BUCKET_SIZE = 4;
+
+        struct Slot
+        {
+            std::atomic<uint64_t> key{0};
+            std::atomic<uint64_t> data{0};
+        };
+
+        struct alignas(64) Bucket
+        {
+            Slot slots[BUCKET_SIZE];
+        };
+
+        std::vector<Bucket> m_Buckets;
+        uint64_t m_IndexMask = 0;
+        std::atomic<uint8_t> m_Generation{0};
+
+        // Every thread counts into one of the stripes, each on its own cache line, so counting does not make the
+        // threads fight over a shared line; GetStats adds them up.
+        static constexpr size_t COUNTER_STRIPES = 16;
+
+        struct alignas(64) Counters
+        {
+            std::atomic<uint64_t> probes{0};
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> stores{0};
+            std::atomic<uint64_t> collisions{0};
+        };
+
+        Counters m_Counters[COUNTER_STRIPES];
+
+    public:
+        // Constructors & Destructors
+        // The bucket count is the largest power of two that fits in megabytes, with at least one bucket.
+        explicit TranspositionTable(size_t megabytes = DEFAULT_SIZE_MB);
+        TranspositionTable(const TranspositionTable &) = delete;
+        TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+        // Getters & Setters
+    public:
+        size_t GetEntryCount() const;
+        size_t GetSizeInBytes() const;
+
+        TranspositionStats GetStats() const;
+        // Fraction of sampled slots holding an entry from the current search.
+        double GetFillRate() const;
+
+        // Public methods
+    public:
+        // Position::GetHash does not tell grid shapes apart, so a table shared across grids is keyed by this.
+        static uint64_t GetKey(const Position &position);
+
+        bool Probe(uint64_t hash, TranspositionEntry &entry);
+        void Store(uint64_t hash, const TranspositionEntry &entry);
+
+        // Ages the stored entries so the next search can replace them first; call once per search.
+        void NewSearch();
+        // Empties the table and resets the counters; not safe while other threads use the table.
+        void Clear();
+        void Resize(size_t megabytes);
+
+        // Private methods
+    private:
+        Counters &GetThreadCounters();
+        static uint64_t Pack(const TranspositionEntry &entry, uint8_t generation);
+        static TranspositionEntry Unpack(uint64_t data);
+        static uint8_t GetGeneration(uint64_t data);
+        static unsigned char GetDepth(uint64_t data);
+    };
+}
\ No newline at end of file
@@ -22,6 +22,12 @@ namespace GridWorks
         return *this;
     }
 
+    ConfigurationBuilder &GameConfigurationBuilder::setWinLength(unsigned char winLength)
+    {
+        m_GameConfiguration.winLength = winLength;
+        return *this;
+    }
+
     ConfigurationBuilder &GameConfigurationBuilder::setMaxPlayers(size_t maxPlayers)
     {
         m_GameConfiguration.maxPlayers = maxPlayers;
@@ -34,11 +40,23 @@ namespace GridWorks
         return *this;
     }
 
+    ConfigurationBuilder &GameConfigurationBuilder::setSearchLimits(const SearchLimits &searchLimits)
+    {
+        m_GameConfiguration.searchLimits = searchLimits;
+        return *this;
+    }
+
     GameConfiguration *GameConfigurationBuilder::build()
     {
         CLI_INFO("Game Name: {0}", m_GameConfiguration.gameName);
         CLI_INFO("Game Description: {0}", m_GameConfiguration.gameDescription);
         CLI_INFO("Grid: {0}", m_GameConfiguration.grid->GetGridInfo());
+        CLI_INFO("Win length: {0}", m_GameConfiguration.winLength);
+        CLI_ASSERT(m_GameConfiguration.winLength > 0, "Win length must be at least 1.");
+        m_GameConfiguration.grid->SetWinLength(m_GameConfiguration.winLength);
+        // Build the shared win line table now instead of inside the first AI move's time budget.
+        m_GameConfiguration.grid->GetWinLines();
+        CLI_INFO("AI search limits: depth {0}, nodes {1}, {2} ms", m_GameConfiguration.searchLimits.maxDepth, m_GameConfiguration.searchLimits.maxNodes, m_GameConfiguration.searchLimits.maxMilliseconds);
         CLI_INFO("Player amount: {0}", m_GameConfiguration.players.size());
         CLI_ASSERT(m_GameConfiguration.players.size() > 1, "TurnManager cannot be initialized due to lack of players.")
         CLI_INFO("Players:\n{0}", PlayerVecToString(m_GameConfiguration.players));
@@ -6,6 +6,7 @@
 #include "Grid/Grid.h"
 #include "Player/Player.h"
 #include "GameLogic/TurnManager.h"
+#include "AI/Engine.h"
 
 namespace GridWorks
 {
@@ -14,8 +15,12 @@ namespace GridWorks
         std::string gameName;
         std::string gameDescription;
         Grid *grid = nullptr;
+        // Amount of consecutive chars needed to win, e.g. 5 for gomoku.
+        unsigned char winLength = 3;
         size_t maxPlayers = 0;
         std::vector<Player *> players;
+        // Budget of every AI move, unless the player sets its own with Player::SetSearchLimits.
+        SearchLimits searchLimits = {0, 0, 5.0};
 
         TurnManager *turnManager = nullptr;
     };
@@ -27,8 +32,10 @@ namespace GridWorks
         virtual ConfigurationBuilder &setGameName(const std::string &gameName) = 0;
         virtual ConfigurationBuilder &setGameDescription(const std::string &gameDescription) = 0;
         virtual ConfigurationBuilder &setGrid(unsigned char rows, unsigned char cols, char initialChar = '.') = 0;
+        virtual ConfigurationBuilder &setWinLength(unsigned char winLength) = 0;
         virtual ConfigurationBuilder &setMaxPlayers(size_t maxPlayers) = 0;
         virtual ConfigurationBuilder &addPlayer(Player *player) = 0;
+        virtual ConfigurationBuilder &setSearchLimits(const SearchLimits &searchLimits) = 0;
         virtual GameConfiguration *build() = 0;
     };
 
@@ -45,8 +52,10 @@ namespace GridWorks
         ConfigurationBuilder &setGameName(const std::string &gameName) override;
         ConfigurationBuilder &setGameDescription(const std::string &gameDescription) override;
         ConfigurationBuilder &setGrid(unsigned char rows, unsigned char cols, char initialChar) override;
+        ConfigurationBuilder &setWinLength(unsigned char winLength) override;
         ConfigurationBuilder &setMaxPlayers(size_t maxPlayers) override;
         ConfigurationBuilder &addPlayer(Player *player) override;
+        ConfigurationBuilder &setSearchLimits(const SearchLimits &searchLimits) override;
         GameConfiguration *build() override;
     };
 }
\ No newline at end of file
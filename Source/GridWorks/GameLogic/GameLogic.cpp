@@ -4,6 +4,9 @@
 
 #include "GameLogic/GameState.h"
 #include "Player/Moves.h"
+#include "AI/AlphaBetaEngine.h"
+#include "AI/Position.h"
+#include "AI/TicTacToe.h"
 
 namespace GridWorks
 {
@@ -14,9 +17,21 @@ namespace GridWorks
     GameOverType GameLogic::m_gameOverType{GameOverType::None};
     Player *GameLogic::m_winner{nullptr};
     bool GameLogic::m_randomizeTurnOrder{true};
+    std::atomic<bool> GameLogic::m_cancelAIMove{false};
+
+    // Result for a move from a solved table; tables store no distances, so a win comes within the empty cells left.
+    static SearchResult MakeSolvedResult(const Position &position, const TablebaseEntry &solved)
+    {
+        const Grid &grid = position.GetGrid();
+        const int emptyCells = static_cast<int>(grid.GetCellCount() - grid.GetOccupiedCount());
+        SearchResult result;
+        result.bestMove = solved.bestMove;
+        result.score = solved.value == ProvenWin ? WIN_SCORE - emptyCells : solved.value == ProvenLoss ? emptyCells - WIN_SCORE : 0;
+        return result;
+    }
 
     // Constructors & Destructors
-    GameLogic::GameLogic()
+    GameLogic::GameLogic() : m_GameConfiguration(nullptr), m_Engine(std::make_unique<AlphaBetaEngine>(std::make_shared<TranspositionTable>()))
     {
     }
 
@@ -114,6 +129,53 @@ namespace GridWorks
         m_randomizeTurnOrder = randomize;
     }
 
+    Engine *GameLogic::GetEngine() const
+    {
+        return i_instance->m_Engine.get();
+    }
+
+    void GameLogic::SetEngine(std::unique_ptr<Engine> engine)
+    {
+        CLI_ASSERT(engine, "Engine cannot be null.");
+        i_instance->m_Engine = std::move(engine);
+    }
+
+    const OpeningBook *GameLogic::GetOpeningBook() const
+    {
+        return i_instance->m_OpeningBook.get();
+    }
+
+    void GameLogic::SetOpeningBook(std::shared_ptr<const OpeningBook> openingBook)
+    {
+        i_instance->m_OpeningBook = std::move(openingBook);
+    }
+
+    const Tablebase *GameLogic::GetTablebase() const
+    {
+        return i_instance->m_Tablebase.get();
+    }
+
+    void GameLogic::SetTablebase(std::shared_ptr<const Tablebase> tablebase)
+    {
+        i_instance->m_Tablebase = std::move(tablebase);
+    }
+
+    bool GameLogic::GetUseTicTacToeTable() const
+    {
+        return i_instance->m_UseTicTacToeTable;
+    }
+
+    void GameLogic::SetUseTicTacToeTable(bool use)
+    {
+        i_instance->m_UseTicTacToeTable = use;
+    }
+
+    bool GameLogic::IsAITurn() const
+    {
+        return m_gameState == GameState::InProgress &&
+               i_instance->m_GameConfiguration->turnManager->GetCurrentPlayer().ptr->GetPlayerType() == PlayerType::AI;
+    }
+
     // Private methods
 
     bool GameLogic::CheckInit()
@@ -199,6 +261,7 @@ namespace GridWorks
             i_instance->ResetPlayers();
 
             m_winner = nullptr;
+            m_cancelAIMove = false;
         }
     }
 
@@ -223,6 +286,8 @@ namespace GridWorks
         {
             if (i_instance->m_GameConfiguration->turnManager->MakeMove(i_instance->m_GameConfiguration->grid, row, col) && m_gameState == GameState::InProgress)
             {
+                // The turn is over, so a cancel sent during it does not stop the next AI move.
+                m_cancelAIMove = false;
                 CLI_TRACE("{}", *i_instance->m_GameConfiguration->grid);
                 switch (i_instance->m_GameConfiguration->turnManager->CheckGameOverState(i_instance->m_GameConfiguration->grid, row, col))
                 {
@@ -253,6 +318,62 @@ namespace GridWorks
         }
     }
 
+    SearchResult GameLogic::MakeAIMove()
+    {
+        CLI_ASSERT(i_instance->IsAITurn(), "MakeAIMove called while it is not an AI player's turn.");
+
+        const Player *player = i_instance->m_GameConfiguration->turnManager->GetCurrentPlayer().ptr;
+        SearchLimits limits = player->GetSearchLimits().value_or(i_instance->m_GameConfiguration->searchLimits);
+        limits.stop = &m_cancelAIMove;
+
+        Position position(i_instance->m_GameConfiguration->grid, i_instance->m_GameConfiguration->turnManager);
+        TablebaseEntry solved;
+        if (i_instance->m_Tablebase && i_instance->m_Tablebase->Probe(position, solved))
+        {
+            SearchResult result = MakeSolvedResult(position, solved);
+            CLI_TRACE("Tablebase picked ({0}, {1}) with score {2}.", result.bestMove.row, result.bestMove.col, result.score);
+
+            MakeMove(result.bestMove.row, result.bestMove.col);
+            return result;
+        }
+
+        BookEntry entry;
+        if (i_instance->m_OpeningBook && i_instance->m_OpeningBook->Probe(position, entry))
+        {
+            SearchResult result;
+            result.bestMove = entry.moves.front();
+            result.score = entry.score;
+            CLI_TRACE("Opening book picked ({0}, {1}) with score {2} from {3} games.", result.bestMove.row, result.bestMove.col, result.score,
+                      entry.count);
+
+            MakeMove(result.bestMove.row, result.bestMove.col);
+            return result;
+        }
+
+        if (i_instance->m_UseTicTacToeTable && TicTacToe::Probe(position, solved))
+        {
+            SearchResult result = MakeSolvedResult(position, solved);
+            CLI_TRACE("3x3 table picked ({0}, {1}) with score {2}.", result.bestMove.row, result.bestMove.col, result.score);
+
+            MakeMove(result.bestMove.row, result.bestMove.col);
+            return result;
+        }
+
+        SearchResult result = i_instance->m_Engine->Search(position, limits);
+        CLI_TRACE("{0} picked ({1}, {2}) with score {3}: depth {4}, {5} nodes, {6} playouts in {7:.2f} ms ({8:.0f} nodes/s, {9:.0f} playouts/s).",
+                  i_instance->m_Engine->GetName(), result.bestMove.row, result.bestMove.col, result.score, result.stats.depth,
+                  result.stats.nodes, result.stats.playouts, result.stats.elapsedMilliseconds, result.stats.GetNodesPerSecond(),
+                  result.stats.GetPlayoutsPerSecond());
+
+        MakeMove(result.bestMove.row, result.bestMove.col);
+        return result;
+    }
+
+    void GameLogic::CancelAIMove()
+    {
+        m_cancelAIMove = true;
+    }
+
     void GameLogic::SwapPlayerPositions()
     {
         if (CheckInit())
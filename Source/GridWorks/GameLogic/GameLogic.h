@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <vector>
@@ -7,6 +9,9 @@
 #include "Grid/Grid.h"
 #include "Player/Player.h"
 #include "GameLogic/GameConfiguration.h"
+#include "AI/Engine.h"
+#include "AI/OpeningBook.h"
+#include "AI/Tablebase.h"
 
 namespace GridWorks
 {
@@ -21,8 +26,17 @@ namespace GridWorks
         static GameOverType m_gameOverType;
         static Player *m_winner;
         static bool m_randomizeTurnOrder;
+        static std::atomic<bool> m_cancelAIMove;
 
         GameConfiguration *m_GameConfiguration;
+        // Picks the moves of PlayerType::AI players.
+        std::unique_ptr<Engine> m_Engine;
+        // Looked up before the engine searches; nullptr when there is none.
+        std::shared_ptr<const OpeningBook> m_OpeningBook;
+        // Looked up before the opening book; nullptr when there is none.
+        std::shared_ptr<const Tablebase> m_Tablebase;
+        // Whether 3x3 games with three in a row are played from the table solved at compile time.
+        bool m_UseTicTacToeTable = true;
 
         // Constructors & Destructors
     protected:
@@ -61,6 +75,24 @@ namespace GridWorks
 
         void SetRandomizeTurnOrder(bool randomize);
 
+        Engine *GetEngine() const;
+        void SetEngine(std::unique_ptr<Engine> engine);
+
+        const OpeningBook *GetOpeningBook() const;
+        // Pass nullptr to search every move.
+        void SetOpeningBook(std::shared_ptr<const OpeningBook> openingBook);
+
+        const Tablebase *GetTablebase() const;
+        // Pass nullptr to search every move.
+        void SetTablebase(std::shared_ptr<const Tablebase> tablebase);
+
+        bool GetUseTicTacToeTable() const;
+        // On by default; turn off to have the engine search 3x3 games too.
+        void SetUseTicTacToeTable(bool use);
+
+        // Whether the game is running and the current player is PlayerType::AI.
+        bool IsAITurn() const;
+
     private:
         static bool CheckInit();
 
@@ -80,6 +112,15 @@ namespace GridWorks
 
         static void MakeMove(unsigned char row, unsigned char col);
 
+        // Lets the engine pick and play a move for the current AI player; returns the search result.
+        // Positions in the tablebase or the opening book, then 3x3 games when the built-in table is on, get their move
+        // without a search, with no nodes in the stats.
+        // The search runs within the player's search limits, or the configuration's if the player has none.
+        static SearchResult MakeAIMove();
+        // Makes the current turn's MakeAIMove stop searching and play the best move found so far, also when sent before
+        // the search starts. Cleared once a move is played or the game is reset; safe from any thread.
+        static void CancelAIMove();
+
         void SwapPlayerPositions();
     };
 }
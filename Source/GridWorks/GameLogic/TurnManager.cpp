@@ -6,6 +6,9 @@
 
 #include <durlib.h>
 
+#include <Grid/Grid.h>
+#include <Grid/FixedGrid.h>
+#include <Grid/Zobrist.h>
 #include <Player/Moves.h>
 #include <Player/Player.h>
 #include <GameLogic/GameConfiguration.h>
@@ -76,40 +79,82 @@ namespace GridWorks
         return m_Players;
     }
 
+    uint64_t TurnManager::GetPositionHash(const Grid *grid) const
+    {
+        return grid->GetHash() ^ Zobrist::GetSideKey(m_currentTurn);
+    }
+
+    CanonicalForm TurnManager::GetCanonicalPositionHash(const Grid *grid) const
+    {
+        return grid->GetCanonicalForm(Zobrist::GetSideKey(m_currentTurn));
+    }
+
+    WinCheckMode TurnManager::GetWinCheckMode() const
+    {
+        return m_winCheckMode;
+    }
+
+    void TurnManager::SetWinCheckMode(WinCheckMode winCheckMode)
+    {
+        m_winCheckMode = winCheckMode;
+    }
+
     // Private methods
     bool TurnManager::IsWinningCondition(Grid *grid, unsigned char row, unsigned char col)
     {
-        char playerChar = grid->GetCharAt(row, col);
-        return grid->CheckForRecurringCharsInRow(playerChar) || grid->CheckForRecurringCharsInCol(playerChar) ||
-               grid->CheckForRecurringCharsInDiagonal(playerChar) || grid->CheckForRecurringCharsInAntiDiagonal(playerChar);
+        switch (m_winCheckMode)
+        {
+        case WinCheckMode::LastMove:
+            return IsLastMoveWin(grid, row, col);
+        case WinCheckMode::FullScan:
+            return IsWinningCondition(grid, grid->GetCharAt(row, col));
+        case WinCheckMode::Validate:
+        {
+            // The LastMove path, the line walk it falls back to and the full scan must all agree.
+            bool lastMoveWin = IsLastMoveWin(grid, row, col);
+            bool lineWalkWin = grid->CheckForRecurringCharsAround(row, col);
+            bool fullScanWin = IsWinningCondition(grid, grid->GetCharAt(row, col));
+            CLI_ASSERT(lastMoveWin == fullScanWin, "Last move win check disagrees with the full scan at ({0}, {1}).", row, col);
+            CLI_ASSERT(lineWalkWin == fullScanWin, "Line walk win check disagrees with the full scan at ({0}, {1}).", row, col);
+            return fullScanWin;
+        }
+        default:
+            throw std::runtime_error("Invalid WinCheckMode.");
+        }
     }
 
-    bool TurnManager::IsWinningCondition(Grid *grid, char playerChar)
+    bool TurnManager::IsLastMoveWin(Grid *grid, unsigned char row, unsigned char col)
     {
-        return grid->CheckForRecurringCharsInRow(playerChar) || grid->CheckForRecurringCharsInCol(playerChar) ||
-               grid->CheckForRecurringCharsInDiagonal(playerChar) || grid->CheckForRecurringCharsInAntiDiagonal(playerChar);
+        // Common shapes have compile-time win lines that run on the grid's own bitsets.
+        bool isWin = false;
+        const uint64_t *words = grid->GetBitBoard().GetWords(grid->GetCharAt(row, col));
+        if (words && VisitFixedGrid(grid->GetRows(), grid->GetCols(), grid->GetWinLength(), [&](auto fixedGrid)
+                                    { isWin = decltype(fixedGrid)::type::HasRunThrough(*words, row, col); }))
+            return isWin;
+        return grid->CheckForRecurringCharsAround(row, col);
     }
 
-    bool TurnManager::IsDrawCondition(Grid *grid, unsigned char row, unsigned char col)
+    bool TurnManager::IsWinningCondition(Grid *grid, char playerChar)
     {
-        // Check if all spots are filled.
-        bool allSpotsFilled = true;
-        for (int row = 0; row < grid->GetRows(); ++row)
+        // MoveType chars are mirrored in the grid's bitsets, which answer with a few shift-and operations.
+        if (BitBoard::IsTracked(playerChar))
         {
-            for (int col = 0; col < grid->GetCols(); ++col)
-            {
-                if (grid->GetCharAt(row, col) == grid->GetDefaultChar())
-                {
-                    allSpotsFilled = false; // Found an empty spot, so not all spots are filled.
-                    break;
-                }
-            }
-            if (!allSpotsFilled)
-                break;
+            bool isWin = false;
+            const uint64_t *words = grid->GetBitBoard().GetWords(playerChar);
+            if (VisitFixedGrid(grid->GetRows(), grid->GetCols(), grid->GetWinLength(), [&](auto fixedGrid)
+                               { isWin = decltype(fixedGrid)::type::HasRun(*words); }))
+                return isWin;
+            return grid->GetBitBoard().HasRun(playerChar, grid->GetWinLength());
         }
+        return grid->CheckForRecurringCharsInRow(playerChar) || grid->CheckForRecurringCharsInCol(playerChar) ||
+               grid->CheckForRecurringCharsInDiagonal(playerChar) || grid->CheckForRecurringCharsInAntiDiagonal(playerChar);
+    }
 
+    bool TurnManager::IsDrawCondition(Grid *grid, bool isWin)
+    {
+        // The grid keeps count of its occupied cells, so a full board is a constant time check.
         // If all spots are filled and there's no win, then it's a draw.
-        return allSpotsFilled && !IsWinningCondition(grid, grid->GetLastChangedChar().first, grid->GetLastChangedChar().second);
+        return grid->IsFull() && !isWin;
     }
 
     // Public methods
@@ -192,12 +237,13 @@ namespace GridWorks
         PlayerNameAndPtr currentPlayer = GetCurrentPlayer();
         // PlayerNameAndPtr previousPlayer = GetPlayerPair((GetCurrentTurn() - 1) % m_Players.size());
 
-        if (IsWinningCondition(grid, row, col))
+        bool isWin = IsWinningCondition(grid, row, col);
+        if (isWin)
         {
             CLI_INFO("Player {0} won the game!", currentPlayer.name);
             return GameOverType::Win;
         }
-        if (IsDrawCondition(grid, row, col))
+        if (IsDrawCondition(grid, isWin))
         {
             CLI_INFO("The game ended in a draw!");
             return GameOverType::Draw;
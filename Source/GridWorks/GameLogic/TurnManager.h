@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "fmt/format.h"
 
+#include "Grid/Symmetry.h"
+
 namespace GridWorks
 {
     // Forward declarations
@@ -14,6 +17,17 @@ namespace GridWorks
     class Grid;
     enum GameOverType;
 
+    // How TurnManager decides whether a move won the game.
+    enum WinCheckMode
+    {
+        // Walk only the four lines through the move that was just played.
+        LastMove = 0,
+        // Scan the whole grid for the player's char.
+        FullScan = 1,
+        // Run both checks and assert that they agree.
+        Validate = 2
+    };
+
     struct PlayerNameAndPtr
     {
         std::string name;
@@ -26,6 +40,7 @@ namespace GridWorks
         std::vector<PlayerNameAndPtr> m_Players;
         size_t m_currentTurn = 0;
         unsigned int m_totalTurns = 0;
+        WinCheckMode m_winCheckMode = WinCheckMode::LastMove;
 
     public:
         // Constructors & Destructors
@@ -61,11 +76,21 @@ namespace GridWorks
 
         std::vector<PlayerNameAndPtr> GetPlayerPairs() const;
 
+        // Zobrist hash of the grid combined with the player whose turn it is.
+        uint64_t GetPositionHash(const Grid *grid) const;
+        // Same as GetPositionHash but identical for every rotation and reflection of the grid.
+        CanonicalForm GetCanonicalPositionHash(const Grid *grid) const;
+
+        WinCheckMode GetWinCheckMode() const;
+        void SetWinCheckMode(WinCheckMode winCheckMode);
+
         // Private methods:
     private:
         bool IsWinningCondition(Grid *grid, unsigned char row, unsigned char col);
         bool IsWinningCondition(Grid *grid, char playerChar);
-        bool IsDrawCondition(Grid *grid, unsigned char row, unsigned char col);
+        // The LastMove check: compile-time win lines for common shapes, the four lines through the move otherwise.
+        bool IsLastMoveWin(Grid *grid, unsigned char row, unsigned char col);
+        bool IsDrawCondition(Grid *grid, bool isWin);
 
         // Public methods:
     public:
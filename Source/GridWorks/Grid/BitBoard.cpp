@@ -0,0 +1,213 @@
+#include "BitBoard.h"
+
+#include <algorithm>
+
+#include "Grid/Grid.h"
+#include "Player/Moves.h"
+
+namespace GridWorks
+{
+    namespace
+    {
+        // Largest board that still fits into a single word with 8 bits per row.
+        constexpr unsigned char SINGLE_WORD_SIZE = 8;
+
+        // Columns of the 8-bits-per-row layout, used to drop bits that wrapped into the neighbouring row.
+        constexpr uint64_t FIRST_COLUMN = 0x0101010101010101ULL;
+        constexpr uint64_t LAST_COLUMN = FIRST_COLUMN << 7;
+
+        int PlayerIndex(char playerChar)
+        {
+            if (playerChar == static_cast<char>(MoveType::X))
+                return 0;
+            if (playerChar == static_cast<char>(MoveType::O))
+                return 1;
+            return -1;
+        }
+
+        // Reads 64 bits starting at bitOffset; bits past the end of the set read as zero.
+        uint64_t Extract64(const uint64_t *words, size_t wordCount, size_t bitOffset)
+        {
+            size_t word = bitOffset / 64;
+            size_t shift = bitOffset % 64;
+            if (word >= wordCount)
+                return 0;
+
+            uint64_t value = words[word] >> shift;
+            if (shift != 0 && word + 1 < wordCount)
+                value |= words[word + 1] << (64 - shift);
+            return value;
+        }
+    }
+
+    // Constructors & Destructors
+    BitBoard::BitBoard(unsigned char rows, unsigned char cols)
+    {
+        Resize(rows, cols);
+    }
+
+    // Getters & Setters
+    unsigned char BitBoard::GetRows() const
+    {
+        return m_Rows;
+    }
+
+    unsigned char BitBoard::GetCols() const
+    {
+        return m_Cols;
+    }
+
+    size_t BitBoard::GetWordCount() const
+    {
+        return m_WordCount;
+    }
+
+    bool BitBoard::IsSingleWord() const
+    {
+        return m_Rows <= SINGLE_WORD_SIZE && m_Cols <= SINGLE_WORD_SIZE;
+    }
+
+    const uint64_t *BitBoard::GetWords(char playerChar) const
+    {
+        int player = PlayerIndex(playerChar);
+        if (player < 0)
+            return nullptr;
+        return m_Words.data() + player * m_WordCount;
+    }
+
+    // Public methods
+    bool BitBoard::IsTracked(char playerChar)
+    {
+        return PlayerIndex(playerChar) >= 0;
+    }
+
+    void BitBoard::Resize(unsigned char rows, unsigned char cols)
+    {
+        m_Rows = rows;
+        m_Cols = cols;
+        m_RowWidth = IsSingleWord() ? SINGLE_WORD_SIZE : static_cast<size_t>(cols) + 1;
+        m_WordCount = IsSingleWord() ? 1 : (rows * m_RowWidth + 63) / 64;
+        m_Words.assign(2 * m_WordCount, 0);
+    }
+
+    void BitBoard::Clear()
+    {
+        std::fill(m_Words.begin(), m_Words.end(), 0);
+    }
+
+    void BitBoard::Rebuild(const GridView &view)
+    {
+        if (view.rows != m_Rows || view.cols != m_Cols)
+            Resize(view.rows, view.cols);
+        else
+            Clear();
+
+        for (unsigned char row = 0; row < view.rows; ++row)
+        {
+            const char *cells = view[row];
+            for (unsigned char col = 0; col < view.cols; ++col)
+            {
+                int player = PlayerIndex(cells[col]);
+                if (player >= 0)
+                {
+                    size_t bit = BitIndex(row, col);
+                    m_Words[player * m_WordCount + bit / 64] |= 1ULL << (bit % 64);
+                }
+            }
+        }
+    }
+
+    void BitBoard::Update(unsigned char row, unsigned char col, char oldChar, char newChar)
+    {
+        size_t bit = BitIndex(row, col);
+        size_t word = bit / 64;
+        uint64_t mask = 1ULL << (bit % 64);
+
+        int oldPlayer = PlayerIndex(oldChar);
+        if (oldPlayer >= 0)
+            m_Words[oldPlayer * m_WordCount + word] &= ~mask;
+
+        int newPlayer = PlayerIndex(newChar);
+        if (newPlayer >= 0)
+            m_Words[newPlayer * m_WordCount + word] |= mask;
+    }
+
+    bool BitBoard::Test(unsigned char row, unsigned char col, char playerChar) const
+    {
+        const uint64_t *words = GetWords(playerChar);
+        if (words == nullptr)
+            return false;
+
+        size_t bit = BitIndex(row, col);
+        return (words[bit / 64] >> (bit % 64)) & 1ULL;
+    }
+
+    bool BitBoard::HasRun(char playerChar, unsigned char runLength) const
+    {
+        const uint64_t *words = GetWords(playerChar);
+        if (words == nullptr || runLength == 0)
+            return false;
+
+        if (IsSingleWord())
+            return HasRunSingleWord(words[0], runLength);
+        return HasRunMultiWord(words, runLength);
+    }
+
+    // Private methods
+    size_t BitBoard::BitIndex(unsigned char row, unsigned char col) const
+    {
+        return row * m_RowWidth + col;
+    }
+
+    bool BitBoard::HasRunSingleWord(uint64_t mask, unsigned char runLength) const
+    {
+        // Each direction moves bit (row, col) onto the bit of the previous cell on the line.
+        // The keep mask clears bits that were shifted across the edge of a row.
+        struct Direction
+        {
+            int shift;
+            uint64_t keep;
+        };
+        static constexpr Direction directions[] = {
+            {1, ~LAST_COLUMN}, // Row
+            {8, ~0ULL},        // Column
+            {9, ~LAST_COLUMN}, // Diagonal
+            {7, ~FIRST_COLUMN} // Anti-diagonal
+        };
+
+        for (const Direction &direction : directions)
+        {
+            // After i steps a bit is still set only if i + 1 consecutive cells starting there are occupied.
+            uint64_t run = mask;
+            for (unsigned char i = 1; i < runLength && run != 0; ++i)
+            {
+                run = mask & ((run >> direction.shift) & direction.keep);
+            }
+            if (run != 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool BitBoard::HasRunMultiWord(const uint64_t *words, unsigned char runLength) const
+    {
+        // The guard bit at the end of every row takes care of row wrapping, so no keep masks are needed.
+        const size_t shifts[] = {1, m_RowWidth, m_RowWidth + 1, m_RowWidth - 1};
+
+        for (size_t shift : shifts)
+        {
+            for (size_t word = 0; word < m_WordCount; ++word)
+            {
+                // AND together the words that start runLength consecutive cells further along the line.
+                uint64_t run = words[word];
+                for (unsigned char i = 1; i < runLength && run != 0; ++i)
+                {
+                    run &= Extract64(words, m_WordCount, word * 64 + i * shift);
+                }
+                if (run != 0)
+                    return true;
+            }
+        }
+        return false;
+    }
+}
\ No newline at end of file
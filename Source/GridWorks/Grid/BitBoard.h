@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace GridWorks
+{
+    struct GridView;
+
+    // Occupancy bitsets for the two MoveTypes placed on a Grid.
+    // Boards up to 8x8 pack into a single uint64_t per MoveType using 8 bits per row.
+    // Larger boards use a multi-word bitset with cols + 1 bits per row; the extra guard bit is always clear,
+    // so runs can never wrap from one row into the next.
+    class BitBoard
+    {
+    private:
+        unsigned char m_Rows = 0;
+        unsigned char m_Cols = 0;
+        // Bits reserved for a single row in the packed layout.
+        size_t m_RowWidth = 0;
+        // Words used by a single MoveType.
+        size_t m_WordCount = 0;
+        // Words for MoveType::X followed by the words for MoveType::O.
+        std::vector<uint64_t> m_Words;
+
+    public:
+        // Constructors & Destructors
+        BitBoard() = default;
+        BitBoard(unsigned char rows, unsigned char cols);
+        ~BitBoard() = default;
+
+        // Getters & Setters
+    public:
+        unsigned char GetRows() const;
+        unsigned char GetCols() const;
+        size_t GetWordCount() const;
+
+        // True when the board fits into one uint64_t per MoveType.
+        bool IsSingleWord() const;
+
+        // Returns the words of a tracked char, nullptr for chars that are not a MoveType.
+        const uint64_t *GetWords(char playerChar) const;
+
+        // Public methods
+    public:
+        static bool IsTracked(char playerChar);
+
+        void Resize(unsigned char rows, unsigned char cols);
+        void Clear();
+        void Rebuild(const GridView &view);
+
+        // Keeps the bitsets in sync with a single cell of the grid changing from oldChar to newChar.
+        void Update(unsigned char row, unsigned char col, char oldChar, char newChar);
+
+        bool Test(unsigned char row, unsigned char col, char playerChar) const;
+
+        // Checks whether playerChar has at least runLength consecutive cells in any row, column or diagonal.
+        bool HasRun(char playerChar, unsigned char runLength) const;
+
+    private:
+        size_t BitIndex(unsigned char row, unsigned char col) const;
+        bool HasRunSingleWord(uint64_t mask, unsigned char runLength) const;
+        bool HasRunMultiWord(const uint64_t *words, unsigned char runLength) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Grid/Grid.h"
+#include "Player/Moves.h"
+
+namespace GridWorks
+{
+    // Grid with its dimensions and win length fixed at compile time.
+    // Cells are packed with the same 8 bits per row layout as a single-word BitBoard, so the static checks can run
+    // directly on the bitsets of a runtime Grid of the same shape. Every win line is a constexpr mask, which lets the
+    // compiler unroll the win and draw checks completely.
+    template <unsigned char Rows, unsigned char Cols, unsigned char K>
+    class FixedGrid
+    {
+        static_assert(Rows >= 1 && Rows <= 8 && Cols >= 1 && Cols <= 8, "FixedGrid only supports grids up to 8x8.");
+        static_assert(K >= 1 && (K <= Rows || K <= Cols), "Win length does not fit into the grid.");
+
+    public:
+        static constexpr unsigned char ROWS = Rows;
+        static constexpr unsigned char COLS = Cols;
+        static constexpr unsigned char WIN_LENGTH = K;
+        static constexpr unsigned char ROW_WIDTH = 8;
+
+        static constexpr uint64_t CellMask(unsigned char row, unsigned char col)
+        {
+            return 1ULL << (row * ROW_WIDTH + col);
+        }
+
+    private:
+        static constexpr uint64_t BuildFullMask()
+        {
+            uint64_t mask = 0;
+            for (unsigned char row = 0; row < Rows; ++row)
+                for (unsigned char col = 0; col < Cols; ++col)
+                    mask |= CellMask(row, col);
+            return mask;
+        }
+
+        static constexpr size_t CountLines()
+        {
+            size_t count = 0;
+            if (K <= Cols)
+                count += Rows * (Cols - K + 1);
+            if (K <= Rows)
+                count += Cols * (Rows - K + 1);
+            if (K <= Rows && K <= Cols)
+                count += 2 * (Rows - K + 1) * (Cols - K + 1);
+            return count;
+        }
+
+        // Mask of the K cells starting at (row, col) and walking in direction (rowStep, colStep).
+        static constexpr uint64_t LineMask(int row, int col, int rowStep, int colStep)
+        {
+            uint64_t mask = 0;
+            for (int i = 0; i < K; ++i)
+                mask |= CellMask(static_cast<unsigned char>(row + i * rowStep), static_cast<unsigned char>(col + i * colStep));
+            return mask;
+        }
+
+    public:
+        static constexpr uint64_t FULL_MASK = BuildFullMask();
+        static constexpr size_t LINE_COUNT = CountLines();
+
+        // Every row, column, diagonal and anti-diagonal segment of length K.
+        static constexpr std::array<uint64_t, LINE_COUNT> LINES = []()
+        {
+            std::array<uint64_t, LINE_COUNT> lines = {};
+            size_t index = 0;
+            for (int row = 0; row < Rows; ++row)
+            {
+                for (int col = 0; col < Cols; ++col)
+                {
+                    if (col + K <= Cols)
+                        lines[index++] = LineMask(row, col, 0, 1);
+                    if (row + K <= Rows)
+                        lines[index++] = LineMask(row, col, 1, 0);
+                    if (row + K <= Rows && col + K <= Cols)
+                        lines[index++] = LineMask(row, col, 1, 1);
+                    if (row + K <= Rows && col - K + 1 >= 0)
+                        lines[index++] = LineMask(row, col, 1, -1);
+                }
+            }
+            return lines;
+        }();
+
+        // Bit distance to the next cell going right, down, down-right and down-left.
+        static constexpr std::array<unsigned char, 4> DIRECTION_SHIFTS = {1, ROW_WIDTH, ROW_WIDTH + 1, ROW_WIDTH - 1};
+
+        // Cells a run of K can start from in each direction without leaving the grid.
+        static constexpr std::array<uint64_t, 4> RUN_STARTS = []()
+        {
+            std::array<uint64_t, 4> starts = {};
+            for (int row = 0; row < Rows; ++row)
+            {
+                for (int col = 0; col < Cols; ++col)
+                {
+                    uint64_t cell = CellMask(static_cast<unsigned char>(row), static_cast<unsigned char>(col));
+                    if (col + K <= Cols)
+                        starts[0] |= cell;
+                    if (row + K <= Rows)
+                        starts[1] |= cell;
+                    if (row + K <= Rows && col + K <= Cols)
+                        starts[2] |= cell;
+                    if (row + K <= Rows && col - K + 1 >= 0)
+                        starts[3] |= cell;
+                }
+            }
+            return starts;
+        }();
+
+        // Static checks on a packed bitset.
+    public:
+        // Shift-and along the 4 directions; with K known the loop unrolls to a handful of ANDs per direction.
+        static constexpr bool HasRun(uint64_t bits)
+        {
+            uint64_t runs = 0;
+            for (size_t direction = 0; direction < 4; ++direction)
+            {
+                uint64_t run = bits & RUN_STARTS[direction];
+                for (unsigned char i = 1; i < K; ++i)
+                    run &= bits >> (i * DIRECTION_SHIFTS[direction]);
+                runs |= run;
+            }
+            return runs != 0;
+        }
+
+        // Only looks at the lines containing (row, col).
+        static constexpr bool HasRunThrough(uint64_t bits, unsigned char row, unsigned char col)
+        {
+            uint64_t cell = CellMask(row, col);
+            bool won = false;
+            for (uint64_t line : LINES)
+                won |= (line & cell) != 0 && (bits & line) == line;
+            return won;
+        }
+
+        static constexpr bool IsFull(uint64_t occupied)
+        {
+            return (occupied & FULL_MASK) == FULL_MASK;
+        }
+
+    private:
+        // Bits of MoveType::X followed by the bits of MoveType::O.
+        uint64_t m_Bits[2] = {0, 0};
+        char m_DefaultChar;
+
+    public:
+        // Constructors & Destructors
+        constexpr FixedGrid(char defaultChar = '.') : m_DefaultChar(defaultChar)
+        {
+        }
+
+        explicit FixedGrid(const Grid &grid) : m_DefaultChar(grid.GetDefaultChar())
+        {
+            if (grid.GetRows() != Rows || grid.GetCols() != Cols)
+            {
+                throw std::invalid_argument("Grid dimensions do not match the FixedGrid");
+            }
+            for (unsigned char row = 0; row < Rows; ++row)
+                for (unsigned char col = 0; col < Cols; ++col)
+                    SetCharAt(row, col, grid.GetCharAt(row, col));
+        }
+
+        // Getters & Setters
+    public:
+        constexpr char GetDefaultChar() const
+        {
+            return m_DefaultChar;
+        }
+
+        constexpr char GetCharAt(unsigned char row, unsigned char col) const
+        {
+            uint64_t cell = CellMask(row, col);
+            if (m_Bits[0] & cell)
+                return static_cast<char>(MoveType::X);
+            if (m_Bits[1] & cell)
+                return static_cast<char>(MoveType::O);
+            return m_DefaultChar;
+        }
+
+        // Chars that are not a MoveType clear the cell.
+        constexpr void SetCharAt(unsigned char row, unsigned char col, char newChar)
+        {
+            uint64_t cell = CellMask(row, col);
+            m_Bits[0] &= ~cell;
+            m_Bits[1] &= ~cell;
+            if (newChar == static_cast<char>(MoveType::X))
+                m_Bits[0] |= cell;
+            else if (newChar == static_cast<char>(MoveType::O))
+                m_Bits[1] |= cell;
+        }
+
+        constexpr uint64_t GetBits(char playerChar) const
+        {
+            if (playerChar == static_cast<char>(MoveType::X))
+                return m_Bits[0];
+            if (playerChar == static_cast<char>(MoveType::O))
+                return m_Bits[1];
+            return 0;
+        }
+
+        // Public methods
+    public:
+        constexpr bool IsWin(char playerChar) const
+        {
+            return HasRun(GetBits(playerChar));
+        }
+
+        constexpr bool IsWinAt(unsigned char row, unsigned char col) const
+        {
+            return HasRunThrough(GetBits(GetCharAt(row, col)), row, col);
+        }
+
+        constexpr bool IsFull() const
+        {
+            return IsFull(m_Bits[0] | m_Bits[1]);
+        }
+
+        constexpr void Clear()
+        {
+            m_Bits[0] = 0;
+            m_Bits[1] = 0;
+        }
+    };
+
+    // Specializations used for the common shapes.
+    using FixedGrid3x3 = FixedGrid<3, 3, 3>;
+    using FixedGrid4x4 = FixedGrid<4, 4, 3>;
+
+    // Calls function with std::type_identity<FixedGrid<...>> when a specialization matches the shape.
+    // Returns false without calling it otherwise, so the caller can fall back to the runtime Grid.
+    template <typename Function>
+    bool VisitFixedGrid(unsigned char rows, unsigned char cols, unsigned char winLength, Function &&function)
+    {
+        if (rows == 3 && cols == 3 && winLength == 3)
+        {
+            function(std::type_identity<FixedGrid3x3>{});
+            return true;
+        }
+        if (rows == 4 && cols == 4 && winLength == 3)
+        {
+            function(std::type_identity<FixedGrid4x4>{});
+            return true;
+        }
+        return false;
+    }
+}
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "Grid.h"
 
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
+
+#include "Grid/RunKernels.h"
+#include "Grid/Zobrist.h"
 
 namespace GridWorks
 {
@@ -9,25 +14,82 @@ namespace GridWorks
     {
         this->rows = rows;
         this->cols = cols;
+        this->stride = cols;
+        this->capacity = static_cast<size_t>(rows) * stride;
 
-        // Allocate memory for the grid.
-        grid = new char *[rows];
-        for (unsigned char i = 0; i < rows; ++i)
-        {
-            grid[i] = new char[cols];
-            // Set each character in this row to the initial char.
-            std::fill_n(grid[i], cols, initialChar);
-        }
+        // Allocate one contiguous block for the whole grid.
+        grid = new char[capacity];
+        std::fill_n(grid, capacity, initialChar);
+
+        RebuildState();
+    }
+
+    Grid::Grid(const Grid &other) : grid(nullptr), capacity(0)
+    {
+        *this = other;
+    }
+
+    Grid::Grid(Grid &&other) noexcept : grid(nullptr), capacity(0)
+    {
+        *this = std::move(other);
     }
 
     Grid::~Grid()
     {
         // Deallocate memory for the grid.
-        for (int i = 0; i < rows; i++)
+        delete[] grid;
+    }
+
+    Grid &Grid::operator=(const Grid &other)
+    {
+        if (this == &other)
+            return *this;
+
+        size_t size = static_cast<size_t>(other.rows) * other.cols;
+        if (size > capacity)
+        {
+            delete[] grid;
+            grid = new char[size];
+            capacity = size;
+        }
+
+        // Pack the rows tightly; the source may have a wider stride left over from a resize.
+        stride = other.cols;
+        if (other.stride == stride)
+        {
+            std::copy_n(other.grid, size, grid);
+        }
+        else
         {
-            delete[] grid[i];
+            for (unsigned char row = 0; row < other.rows; ++row)
+            {
+                std::copy_n(other.grid + row * other.stride, other.cols, grid + row * stride);
+            }
         }
+        CopyStateFrom(other);
+        bitBoard = other.bitBoard;
+        return *this;
+    }
+
+    Grid &Grid::operator=(Grid &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
         delete[] grid;
+        grid = std::exchange(other.grid, nullptr);
+        capacity = std::exchange(other.capacity, 0);
+        stride = std::exchange(other.stride, 0);
+        CopyStateFrom(other);
+        bitBoard = std::move(other.bitBoard);
+
+        // Leave other as an empty 0x0 grid.
+        other.rows = 0;
+        other.cols = 0;
+        other.occupiedCount = 0;
+        std::fill(std::begin(other.hashes), std::end(other.hashes), 0);
+        other.bitBoard = BitBoard();
+        return *this;
     }
 
     // Getters & Setters
@@ -39,7 +101,13 @@ namespace GridWorks
 
     void Grid::SetRows(unsigned char rows)
     {
+        if (static_cast<size_t>(rows) * stride > capacity)
+        {
+            throw std::out_of_range("Rows do not fit the grid buffer; use ResetGridWithNewSize to grow the grid");
+        }
+
         this->rows = rows;
+        RebuildState();
     }
 
     unsigned char Grid::GetCols() const
@@ -49,17 +117,41 @@ namespace GridWorks
 
     void Grid::SetCols(unsigned char cols)
     {
+        // Rows start every stride chars, so a row can not grow past it.
+        if (cols > stride)
+        {
+            throw std::out_of_range("Cols do not fit the grid buffer; use ResetGridWithNewSize to grow the grid");
+        }
+
         this->cols = cols;
+        RebuildState();
     }
 
-    char **Grid::GetGrid() const
+    GridView Grid::GetGrid() const
     {
-        return grid;
+        return GridView{grid, rows, cols, stride};
     }
 
-    void Grid::SetGrid(char **grid)
+    void Grid::SetGrid(const GridView &view)
     {
-        this->grid = grid;
+        if (view.rows != rows || view.cols != cols)
+        {
+            throw std::invalid_argument("Grid view dimensions do not match the grid");
+        }
+
+        // Both buffers are row-major, so a matching stride lets us copy everything at once.
+        if (view.stride == stride)
+        {
+            std::copy_n(view.data, static_cast<size_t>(rows) * stride, grid);
+        }
+        else
+        {
+            for (unsigned char row = 0; row < rows; ++row)
+            {
+                std::copy_n(view[row], cols, grid + row * stride);
+            }
+        }
+        RebuildState();
     }
 
     char Grid::GetDefaultChar() const
@@ -67,14 +159,29 @@ namespace GridWorks
         return defaultChar;
     }
 
+    unsigned char Grid::GetWinLength() const
+    {
+        return winLength;
+    }
+
+    void Grid::SetWinLength(unsigned char winLength)
+    {
+        if (winLength == 0)
+        {
+            throw std::invalid_argument("Win length must be at least 1");
+        }
+        this->winLength = winLength;
+    }
+
     void Grid::SetDefaultChar(char defaultChar)
     {
         this->defaultChar = defaultChar;
+        occupiedCount = CountOccupiedCells();
     }
 
     char Grid::GetCharAt(unsigned char row, unsigned char col) const
     {
-        return grid[row][col];
+        return grid[row * stride + col];
     }
 
     void Grid::SetCharAt(unsigned char row, unsigned char col, char newChar)
@@ -85,7 +192,18 @@ namespace GridWorks
         }
         lastChangedChar[0] = row;
         lastChangedChar[1] = col;
-        grid[row][col] = newChar;
+        char &cell = grid[row * stride + col];
+        bitBoard.Update(row, col, cell, newChar);
+        occupiedCount += (newChar != defaultChar) - (cell != defaultChar);
+        for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+        {
+            Symmetry symmetry = static_cast<Symmetry>(i);
+            if (!IsSymmetryValid(symmetry, rows, cols))
+                continue;
+            auto [symmetryRow, symmetryCol] = ApplySymmetry(symmetry, row, col, rows, cols);
+            hashes[i] ^= Zobrist::GetCellKey(symmetryRow, symmetryCol, cell) ^ Zobrist::GetCellKey(symmetryRow, symmetryCol, newChar);
+        }
+        cell = newChar;
     }
 
     std::pair<unsigned char, unsigned char> Grid::GetLastChangedChar() const
@@ -93,6 +211,64 @@ namespace GridWorks
         return std::make_pair(lastChangedChar[0], lastChangedChar[1]);
     }
 
+    void Grid::SetLastChangedChar(unsigned char row, unsigned char col)
+    {
+        lastChangedChar[0] = row;
+        lastChangedChar[1] = col;
+    }
+
+    const BitBoard &Grid::GetBitBoard() const
+    {
+        return bitBoard;
+    }
+
+    const WinLineTable &Grid::GetWinLines() const
+    {
+        if (!winLines || winLines->GetRows() != rows || winLines->GetCols() != cols || winLines->GetWinLength() != winLength)
+            winLines = WinLineTable::Get(rows, cols, winLength);
+        return *winLines;
+    }
+
+    size_t Grid::GetCellCount() const
+    {
+        return static_cast<size_t>(rows) * cols;
+    }
+
+    size_t Grid::GetOccupiedCount() const
+    {
+        return occupiedCount;
+    }
+
+    bool Grid::IsFull() const
+    {
+        return occupiedCount == GetCellCount();
+    }
+
+    uint64_t Grid::GetHash() const
+    {
+        return hashes[Symmetry::Identity];
+    }
+
+    uint64_t Grid::GetSymmetryHash(Symmetry symmetry) const
+    {
+        return hashes[symmetry];
+    }
+
+    CanonicalForm Grid::GetCanonicalForm(uint64_t salt) const
+    {
+        CanonicalForm canonical = {hashes[Symmetry::Identity] ^ salt, Symmetry::Identity};
+        for (unsigned char i = 1; i < SYMMETRY_COUNT; ++i)
+        {
+            Symmetry symmetry = static_cast<Symmetry>(i);
+            if (!IsSymmetryValid(symmetry, rows, cols))
+                continue;
+            uint64_t candidate = hashes[i] ^ salt;
+            if (candidate < canonical.hash)
+                canonical = {candidate, symmetry};
+        }
+        return canonical;
+    }
+
     // Operators
 
     char *Grid::operator[](int index)
@@ -101,7 +277,7 @@ namespace GridWorks
         {
             throw std::out_of_range("Index out of bounds");
         }
-        return grid[index];
+        return grid + index * stride;
     }
 
     // Public methods
@@ -112,36 +288,29 @@ namespace GridWorks
 
     void Grid::ResetGrid()
     {
-        for (int i = 0; i < rows; i++)
-        {
-            std::fill_n(grid[i], cols, defaultChar);
-        }
+        std::fill_n(grid, static_cast<size_t>(rows) * stride, defaultChar);
         lastChangedChar[0] = 0;
         lastChangedChar[1] = 0;
+        RebuildState();
     }
 
     void Grid::ResetGridWithNewSize(unsigned char newRows, unsigned char newCols, char newChar)
     {
         defaultChar = newChar;
-        ResetGrid();
 
-        // Deallocate memory for the grid.
-        for (int i = 0; i < rows; i++)
+        // Reallocate the block only when the new grid does not fit into the current one.
+        size_t newSize = static_cast<size_t>(newRows) * newCols;
+        if (newSize > capacity)
         {
-            delete[] grid[i];
+            delete[] grid;
+            grid = new char[newSize];
+            capacity = newSize;
         }
-        delete[] grid;
 
-        // Allocate memory for the grid.
         this->rows = newRows;
         this->cols = newCols;
-        grid = new char *[rows];
-        for (unsigned char i = 0; i < rows; ++i)
-        {
-            grid[i] = new char[cols];
-            // Set each character in this row to the initial char.
-            std::fill_n(grid[i], cols, newChar);
-        }
+        this->stride = newCols;
+        ResetGrid();
     }
 
     void Grid::ResetGridWithNewChar(char newChar)
@@ -152,62 +321,36 @@ namespace GridWorks
 
     // Previous methods checked for the occurrence of a character in a row, column, diagonal or anti-diagonal.
     // But it checked the whole row, column, diagonal or anti-diagonal.
-    // This is incorrect. Because we need to check for at the very least 3 occurrences of the character in a row.
+    // This is incorrect. Because we need to check for at the very least winLength occurrences of the character in a row.
     bool Grid::CheckForRecurringCharsInRow(char playerChar)
     {
         for (int row = 0; row < rows; ++row)
         {
-            int count = 0;
-            for (int col = 0; col < cols; ++col)
-            {
-                if (GetCharAt(row, col) == playerChar)
-                {
-                    if (++count >= 3)
-                        return true;
-                }
-                else
-                {
-                    count = 0;
-                }
-            }
+            if (RunKernels::HasRowRun(grid + row * stride, cols, playerChar, winLength))
+                return true;
         }
         return false;
     }
 
     bool Grid::CheckForRecurringCharsInCol(char playerChar)
     {
-        for (int col = 0; col < cols; ++col)
-        {
-            int count = 0;
-            for (int row = 0; row < rows; ++row)
-            {
-                if (GetCharAt(row, col) == playerChar)
-                {
-                    if (++count >= 3)
-                        return true;
-                }
-                else
-                {
-                    count = 0;
-                }
-            }
-        }
-        return false;
+        return RunKernels::HasColumnRun(grid, rows, cols, stride, playerChar, winLength);
     }
 
     bool Grid::CheckForRecurringCharsInDiagonal(char playerChar)
     {
         // Check from top-left to bottom-right
-        for (int row = 0; row <= rows - 3; ++row)
+        for (int row = 0; row <= rows - winLength; ++row)
         {
-            for (int col = 0; col <= cols - 3; ++col)
+            for (int col = 0; col <= cols - winLength; ++col)
             {
+                const char *cell = grid + row * stride + col;
                 int count = 0;
-                for (int i = 0; i + row < rows && i + col < cols; ++i)
+                for (int i = 0; i + row < rows && i + col < cols; ++i, cell += stride + 1)
                 {
-                    if (GetCharAt(row + i, col + i) == playerChar)
+                    if (*cell == playerChar)
                     {
-                        if (++count >= 3)
+                        if (++count >= winLength)
                             return true;
                     }
                     else
@@ -223,16 +366,17 @@ namespace GridWorks
     bool Grid::CheckForRecurringCharsInAntiDiagonal(char playerChar)
     {
         // Check from top-right to bottom-left
-        for (int row = 0; row <= rows - 3; ++row)
+        for (int row = 0; row <= rows - winLength; ++row)
         {
-            for (int col = cols - 1; col >= 2; --col)
+            for (int col = cols - 1; col >= winLength - 1; --col)
             {
+                const char *cell = grid + row * stride + col;
                 int count = 0;
-                for (int i = 0; i + row < rows && col - i >= 0; ++i)
+                for (int i = 0; i + row < rows && col - i >= 0; ++i, cell += stride - 1)
                 {
-                    if (GetCharAt(row + i, col - i) == playerChar)
+                    if (*cell == playerChar)
                     {
-                        if (++count >= 3)
+                        if (++count >= winLength)
                             return true;
                     }
                     else
@@ -245,6 +389,35 @@ namespace GridWorks
         return false;
     }
 
+    // The full scans above look at the whole grid, but a win can only appear on a line through the cell that just changed.
+    // Counting matching neighbours in both directions of the four lines is enough, and each walk stops after winLength - 1 cells.
+    bool Grid::CheckForRecurringCharsAround(unsigned char row, unsigned char col) const
+    {
+        const char playerChar = GetCharAt(row, col);
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+        for (const auto &direction : directions)
+        {
+            int count = 1;
+            for (int sign = -1; sign <= 1; sign += 2)
+            {
+                int r = row + sign * direction[0];
+                int c = col + sign * direction[1];
+                for (int i = 1; i < winLength && r >= 0 && r < rows && c >= 0 && c < cols; ++i)
+                {
+                    if (grid[r * stride + c] != playerChar)
+                        break;
+                    ++count;
+                    r += sign * direction[0];
+                    c += sign * direction[1];
+                }
+            }
+            if (count >= winLength)
+                return true;
+        }
+        return false;
+    }
+
     char Grid::GetCharCenterMostElement() const
     {
         unsigned char centerRow = rows / 2;
@@ -272,4 +445,86 @@ namespace GridWorks
 
         return std::make_pair(centerRow, centerCol);
     }
+
+    std::span<const uint16_t> Grid::GetWinningLine(unsigned char row, unsigned char col) const
+    {
+        const char playerChar = GetCharAt(row, col);
+        if (playerChar == defaultChar)
+            return {};
+
+        const WinLineTable &lines = GetWinLines();
+        for (uint32_t line : lines.GetLinesThrough(row, col))
+        {
+            if (IsLineOf(line, playerChar))
+                return lines.GetLineCells(line);
+        }
+        return {};
+    }
+
+    // Private methods
+    size_t Grid::CellIndex(uint16_t cell) const
+    {
+        return stride == cols ? cell : (cell / cols) * stride + cell % cols;
+    }
+
+    bool Grid::IsLineOf(size_t line, char playerChar) const
+    {
+        for (uint16_t cell : GetWinLines().GetLineCells(line))
+        {
+            if (grid[CellIndex(cell)] != playerChar)
+                return false;
+        }
+        return true;
+    }
+
+    void Grid::CopyStateFrom(const Grid &other)
+    {
+        rows = other.rows;
+        cols = other.cols;
+        defaultChar = other.defaultChar;
+        winLength = other.winLength;
+        lastChangedChar[0] = other.lastChangedChar[0];
+        lastChangedChar[1] = other.lastChangedChar[1];
+        occupiedCount = other.occupiedCount;
+        std::copy(std::begin(other.hashes), std::end(other.hashes), hashes);
+        winLines = other.winLines;
+    }
+
+    void Grid::RebuildState()
+    {
+        bitBoard.Rebuild(GetGrid());
+        occupiedCount = CountOccupiedCells();
+        ComputeHashes();
+    }
+
+    size_t Grid::CountOccupiedCells() const
+    {
+        size_t count = 0;
+        for (unsigned char row = 0; row < rows; ++row)
+        {
+            const char *cells = grid + row * stride;
+            count += cols - std::count(cells, cells + cols, defaultChar);
+        }
+        return count;
+    }
+
+    void Grid::ComputeHashes()
+    {
+        std::fill(std::begin(hashes), std::end(hashes), 0);
+        for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+        {
+            Symmetry symmetry = static_cast<Symmetry>(i);
+            if (!IsSymmetryValid(symmetry, rows, cols))
+                continue;
+            for (unsigned char row = 0; row < rows; ++row)
+            {
+                const char *cells = grid + row * stride;
+                for (unsigned char col = 0; col < cols; ++col)
+                {
+                    auto [symmetryRow, symmetryCol] = ApplySymmetry(symmetry, row, col, rows, cols);
+                    hashes[i] ^= Zobrist::GetCellKey(symmetryRow, symmetryCol, cells[col]);
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -1,49 +1,126 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <span>
+
 #include "fmt/format.h"
 
+#include "Grid/BitBoard.h"
+#include "Grid/Symmetry.h"
+#include "Grid/WinLineTable.h"
+
 namespace GridWorks
 {
+    // Read-only view over the contiguous storage of a Grid.
+    // Cell (row, col) lives at data[row * stride + col]; the view stays valid until the grid is resized.
+    struct GridView
+    {
+        const char *data = nullptr;
+        unsigned char rows = 0;
+        unsigned char cols = 0;
+        size_t stride = 0;
+
+        const char *operator[](size_t row) const { return data + row * stride; }
+
+        char At(unsigned char row, unsigned char col) const { return data[row * stride + col]; }
+
+        std::span<const char> Row(unsigned char row) const { return {data + row * stride, cols}; }
+    };
+
     class Grid
     {
     private:
         // Limit grid size to 255x255.
         unsigned char rows;
         unsigned char cols;
-        // Use a 2D array of chars to represent the grid.
-        char **grid;
+        // Single row-major buffer holding every cell of the grid.
+        char *grid;
+        // Distance in chars between the starts of two consecutive rows.
+        size_t stride;
+        // Number of chars allocated for the buffer.
+        size_t capacity;
 
         // Store default char for resetting the grid.
         char defaultChar;
 
+        // Amount of consecutive chars needed to win.
+        unsigned char winLength = 3;
+
         // Store which element was last changed.
         unsigned char lastChangedChar[2] = {0, 0};
 
+        // Number of cells not holding the default char.
+        size_t occupiedCount = 0;
+
+        // Zobrist hash of the MoveType chars on the grid as seen through every Symmetry, updated with XOR on every SetCharAt.
+        // hashes[Identity] is the plain position hash; symmetries that do not fit the grid shape stay 0.
+        uint64_t hashes[SYMMETRY_COUNT] = {};
+
+        // Occupancy bitsets for every MoveType, kept in sync by SetCharAt and the reset methods.
+        BitBoard bitBoard;
+
+        // Shared line table for the current shape and win length, fetched on first use after either changes.
+        mutable std::shared_ptr<const WinLineTable> winLines;
+
     public:
         // Constructors & Destructors
         Grid(unsigned char rows, unsigned char cols, char initialChar = '.');
+        // Copies are deep; the copy only allocates rows * cols chars.
+        Grid(const Grid &other);
+        Grid(Grid &&other) noexcept;
         ~Grid();
 
+        // Reuses the existing buffer when it is large enough, so copying into a pre-sized grid does not allocate.
+        Grid &operator=(const Grid &other);
+        Grid &operator=(Grid &&other) noexcept;
+
         // Getters & Setters
     public:
         unsigned char GetRows() const;
+        // Shrinks or regrows the grid within its buffer; throws std::out_of_range if the new shape does not fit.
         void SetRows(unsigned char rows);
 
         unsigned char GetCols() const;
+        // Same as SetRows, for the columns.
         void SetCols(unsigned char cols);
 
-        char **GetGrid() const;
-        void SetGrid(char **grid);
+        GridView GetGrid() const;
+        void SetGrid(const GridView &view);
 
         char GetDefaultChar() const;
         void SetDefaultChar(char defaultChar);
 
+        unsigned char GetWinLength() const;
+        void SetWinLength(unsigned char winLength);
+
         char GetCharAt(unsigned char row, unsigned char col) const;
         void SetCharAt(unsigned char row, unsigned char col, char newChar);
 
         std::pair<unsigned char, unsigned char> GetLastChangedChar() const;
+        // Only moves the marker; used to restore it when a move is taken back.
+        void SetLastChangedChar(unsigned char row, unsigned char col);
+
+        const BitBoard &GetBitBoard() const;
+
+        const WinLineTable &GetWinLines() const;
+
+        size_t GetCellCount() const;
+        size_t GetOccupiedCount() const;
+        bool IsFull() const;
+
+        // 64-bit position key; it does not include the side to move, see TurnManager::GetPositionHash.
+        uint64_t GetHash() const;
+
+        // Hash of the grid once transformed by symmetry; 0 if the symmetry does not fit the grid shape.
+        uint64_t GetSymmetryHash(Symmetry symmetry) const;
+
+        // Smallest (hash ^ salt) over the symmetries of the grid and the symmetry that produces it.
+        // Pass the side to move key as salt to canonicalize a full position.
+        CanonicalForm GetCanonicalForm(uint64_t salt = 0) const;
 
         // Overload the [] operator to access the grid.
+        // Writes through the returned row pointer bypass SetCharAt.
     public:
         char *operator[](int index);
 
@@ -59,8 +136,26 @@ namespace GridWorks
         bool CheckForRecurringCharsInDiagonal(char playerChar);
         bool CheckForRecurringCharsInAntiDiagonal(char playerChar);
 
+        // Only walks the row, column, diagonal and anti-diagonal through the given cell.
+        bool CheckForRecurringCharsAround(unsigned char row, unsigned char col) const;
+
+        // Cells of a completed line through (row, col) as WinLineTable cell ids, empty if there is none.
+        std::span<const uint16_t> GetWinningLine(unsigned char row, unsigned char col) const;
+
         char GetCharCenterMostElement() const;
         std::pair<unsigned char, unsigned char> GetCenterMostCoords() const;
+
+        // Private methods
+    private:
+        // Copies the dimensions, counters and hashes from other; the buffer and bitsets are handled by the caller.
+        void CopyStateFrom(const Grid &other);
+        // Offset of a WinLineTable cell id in the buffer.
+        size_t CellIndex(uint16_t cell) const;
+        bool IsLineOf(size_t line, char playerChar) const;
+        // Recomputes everything derived from the cells: bitsets, occupied count and hash.
+        void RebuildState();
+        size_t CountOccupiedCells() const;
+        void ComputeHashes();
     };
 }
 
@@ -0,0 +1,119 @@
+#include "GridPool.h"
+
+#include <utility>
+
+namespace GridWorks
+{
+    // GridSnapshot
+
+    // Constructors & Destructors
+    GridSnapshot::GridSnapshot(GridPool *pool, Grid *grid) : m_Pool(pool), m_Grid(grid)
+    {
+    }
+
+    GridSnapshot::GridSnapshot(GridSnapshot &&other) noexcept
+        : m_Pool(std::exchange(other.m_Pool, nullptr)), m_Grid(std::exchange(other.m_Grid, nullptr))
+    {
+    }
+
+    GridSnapshot::~GridSnapshot()
+    {
+        Release();
+    }
+
+    GridSnapshot &GridSnapshot::operator=(GridSnapshot &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_Pool = std::exchange(other.m_Pool, nullptr);
+            m_Grid = std::exchange(other.m_Grid, nullptr);
+        }
+        return *this;
+    }
+
+    // Getters & Setters
+
+    Grid *GridSnapshot::GetGrid() const
+    {
+        return m_Grid;
+    }
+
+    // Operators
+
+    Grid &GridSnapshot::operator*() const
+    {
+        return *m_Grid;
+    }
+
+    Grid *GridSnapshot::operator->() const
+    {
+        return m_Grid;
+    }
+
+    GridSnapshot::operator bool() const
+    {
+        return m_Grid != nullptr;
+    }
+
+    // Public methods
+
+    void GridSnapshot::Release()
+    {
+        if (m_Pool && m_Grid)
+            m_Pool->Release(m_Grid);
+        m_Pool = nullptr;
+        m_Grid = nullptr;
+    }
+
+    // GridPool
+
+    // Constructors & Destructors
+    GridPool::GridPool(unsigned char rows, unsigned char cols, size_t size) : m_Rows(rows), m_Cols(cols)
+    {
+        Grow(size);
+    }
+
+    // Getters & Setters
+
+    size_t GridPool::GetSize() const
+    {
+        return m_Grids.size();
+    }
+
+    size_t GridPool::GetFreeCount() const
+    {
+        return m_Free.size();
+    }
+
+    // Public methods
+
+    GridSnapshot GridPool::Acquire(const Grid &source)
+    {
+        if (m_Free.empty())
+            Grow(m_Grids.empty() ? 1 : m_Grids.size());
+
+        Grid *grid = m_Free.back();
+        m_Free.pop_back();
+        *grid = source;
+        return GridSnapshot(this, grid);
+    }
+
+    // Private methods
+
+    void GridPool::Release(Grid *grid)
+    {
+        m_Free.push_back(grid);
+    }
+
+    void GridPool::Grow(size_t count)
+    {
+        m_Grids.reserve(m_Grids.size() + count);
+        m_Free.reserve(m_Grids.size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_Grids.push_back(std::make_unique<Grid>(m_Rows, m_Cols));
+            m_Free.push_back(m_Grids.back().get());
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Grid/Grid.h"
+
+namespace GridWorks
+{
+    class GridPool;
+
+    // Pooled copy of a Grid; hands the grid back to its pool when destroyed.
+    class GridSnapshot
+    {
+    private:
+        GridPool *m_Pool = nullptr;
+        Grid *m_Grid = nullptr;
+
+    public:
+        // Constructors & Destructors
+        GridSnapshot() = default;
+        GridSnapshot(GridPool *pool, Grid *grid);
+        GridSnapshot(const GridSnapshot &) = delete;
+        GridSnapshot(GridSnapshot &&other) noexcept;
+        ~GridSnapshot();
+
+        GridSnapshot &operator=(const GridSnapshot &) = delete;
+        GridSnapshot &operator=(GridSnapshot &&other) noexcept;
+
+        // Getters & Setters
+    public:
+        Grid *GetGrid() const;
+
+        // Operators
+    public:
+        Grid &operator*() const;
+        Grid *operator->() const;
+        explicit operator bool() const;
+
+        // Public methods
+    public:
+        // Returns the grid to the pool early.
+        void Release();
+    };
+
+    // Set of pre-allocated grids to copy positions into without touching the heap.
+    // A pool is not thread safe; give every worker thread its own pool.
+    class GridPool
+    {
+    private:
+        unsigned char m_Rows;
+        unsigned char m_Cols;
+        std::vector<std::unique_ptr<Grid>> m_Grids;
+        // Grids that are not handed out, reserved up front so releasing never allocates.
+        std::vector<Grid *> m_Free;
+
+    public:
+        // Constructors & Destructors
+        GridPool(unsigned char rows, unsigned char cols, size_t size);
+        GridPool(const GridPool &) = delete;
+        GridPool &operator=(const GridPool &) = delete;
+
+        // Getters & Setters
+    public:
+        size_t GetSize() const;
+        size_t GetFreeCount() const;
+
+        // Public methods
+    public:
+        // Copies source into a free grid.
+        // Does not allocate as long as a grid is free and source fits in rows x cols; otherwise the pool grows.
+        GridSnapshot Acquire(const Grid &source);
+
+        // Private methods
+    private:
+        friend class GridSnapshot;
+        void Release(Grid *grid);
+        void Grow(size_t count);
+    };
+}
\ No newline at end of file
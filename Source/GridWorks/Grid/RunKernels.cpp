@@ -0,0 +1,213 @@
+#include "RunKernels.h"
+
+#include <bit>
+#include <cstdint>
+
+#if !defined(GW_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define GW_RUN_KERNELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define GW_RUN_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace GridWorks
+{
+    namespace RunKernels
+    {
+        namespace
+        {
+            // Checks for runLength consecutive set bits; runLength must not exceed the mask width.
+            // Every step doubles the run length that survives, so this takes O(log runLength) operations.
+            bool MaskHasRun(uint32_t mask, unsigned char runLength)
+            {
+                unsigned int length = 1;
+                while (length * 2 <= runLength && mask != 0)
+                {
+                    mask &= mask >> length;
+                    length *= 2;
+                }
+                // Runs of length are known, and runLength - length < length, so one overlapping step finishes it.
+                if (length < runLength)
+                    mask &= mask >> (runLength - length);
+                return mask != 0;
+            }
+
+#if defined(GW_RUN_KERNELS_AVX2)
+            struct Simd
+            {
+                using Vector = __m256i;
+                static constexpr unsigned int WIDTH = 32;
+                static constexpr uint32_t FULL_MASK = 0xFFFFFFFF;
+
+                static Vector Load(const char *cells) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cells)); }
+                static Vector Broadcast(char value) { return _mm256_set1_epi8(value); }
+                static Vector Zero() { return _mm256_setzero_si256(); }
+                static Vector CompareEqual(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+                static Vector Sub(Vector a, Vector b) { return _mm256_sub_epi8(a, b); }
+                static Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+                static uint32_t MoveMask(Vector a) { return static_cast<uint32_t>(_mm256_movemask_epi8(a)); }
+                static bool AnyAtLeast(Vector counts, Vector threshold) { return MoveMask(_mm256_cmpeq_epi8(_mm256_max_epu8(counts, threshold), counts)) != 0; }
+            };
+#elif defined(GW_RUN_KERNELS_SSE2)
+            struct Simd
+            {
+                using Vector = __m128i;
+                static constexpr unsigned int WIDTH = 16;
+                static constexpr uint32_t FULL_MASK = 0xFFFF;
+
+                static Vector Load(const char *cells) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(cells)); }
+                static Vector Broadcast(char value) { return _mm_set1_epi8(value); }
+                static Vector Zero() { return _mm_setzero_si128(); }
+                static Vector CompareEqual(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+                static Vector Sub(Vector a, Vector b) { return _mm_sub_epi8(a, b); }
+                static Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+                static uint32_t MoveMask(Vector a) { return static_cast<uint32_t>(_mm_movemask_epi8(a)); }
+                static bool AnyAtLeast(Vector counts, Vector threshold) { return MoveMask(_mm_cmpeq_epi8(_mm_max_epu8(counts, threshold), counts)) != 0; }
+            };
+#endif
+
+#if defined(GW_RUN_KERNELS_AVX2) || defined(GW_RUN_KERNELS_SSE2)
+            bool HasRowRunSimd(const char *cells, size_t length, char playerChar, unsigned char runLength)
+            {
+                const Simd::Vector needle = Simd::Broadcast(playerChar);
+
+                // Matching cells at the end of the previous block, a run can continue into the next one.
+                unsigned int carry = 0;
+                size_t i = 0;
+                for (; i + Simd::WIDTH <= length; i += Simd::WIDTH)
+                {
+                    // Bit n of the mask is set when cell i + n holds playerChar.
+                    uint32_t mask = Simd::MoveMask(Simd::CompareEqual(Simd::Load(cells + i), needle));
+                    if (mask == Simd::FULL_MASK)
+                    {
+                        carry += Simd::WIDTH;
+                        if (carry >= runLength)
+                            return true;
+                        continue;
+                    }
+
+                    if (carry + std::countr_one(mask) >= runLength)
+                        return true;
+                    if (runLength <= Simd::WIDTH && MaskHasRun(mask, runLength))
+                        return true;
+                    carry = std::countl_one(static_cast<uint32_t>(mask << (32 - Simd::WIDTH)));
+                }
+
+                for (; i < length; ++i)
+                {
+                    if (cells[i] == playerChar)
+                    {
+                        if (++carry >= runLength)
+                            return true;
+                    }
+                    else
+                    {
+                        carry = 0;
+                    }
+                }
+                return false;
+            }
+
+            bool HasColumnRunSimd(const char *cells, unsigned char rows, unsigned char cols, size_t stride, char playerChar, unsigned char runLength)
+            {
+                const Simd::Vector needle = Simd::Broadcast(playerChar);
+                const Simd::Vector threshold = Simd::Broadcast(static_cast<char>(runLength));
+
+                // Walk WIDTH columns at once, keeping one run counter per column in each byte lane.
+                // Rows are at most 255, so the counters never overflow.
+                unsigned int col = 0;
+                for (; col + Simd::WIDTH <= cols; col += Simd::WIDTH)
+                {
+                    Simd::Vector counts = Simd::Zero();
+                    const char *cell = cells + col;
+                    for (unsigned char row = 0; row < rows; ++row, cell += stride)
+                    {
+                        // Matching lanes are all ones (-1): subtracting increments the counter, the AND resets the others.
+                        Simd::Vector match = Simd::CompareEqual(Simd::Load(cell), needle);
+                        counts = Simd::And(Simd::Sub(counts, match), match);
+                        if (row + 1 >= runLength && Simd::AnyAtLeast(counts, threshold))
+                            return true;
+                    }
+                }
+
+                if (col < cols)
+                    return HasColumnRunScalar(cells + col, rows, static_cast<unsigned char>(cols - col), stride, playerChar, runLength);
+                return false;
+            }
+#endif
+        }
+
+        const char *GetInstructionSet()
+        {
+#if defined(GW_RUN_KERNELS_AVX2)
+            return "AVX2";
+#elif defined(GW_RUN_KERNELS_SSE2)
+            return "SSE2";
+#else
+            return "Scalar";
+#endif
+        }
+
+        bool HasRowRun(const char *cells, size_t length, char playerChar, unsigned char runLength)
+        {
+#if defined(GW_RUN_KERNELS_AVX2) || defined(GW_RUN_KERNELS_SSE2)
+            if (length >= Simd::WIDTH)
+                return HasRowRunSimd(cells, length, playerChar, runLength);
+#endif
+            return HasRowRunScalar(cells, length, playerChar, runLength);
+        }
+
+        bool HasColumnRun(const char *cells, unsigned char rows, unsigned char cols, size_t stride, char playerChar, unsigned char runLength)
+        {
+#if defined(GW_RUN_KERNELS_AVX2) || defined(GW_RUN_KERNELS_SSE2)
+            if (cols >= Simd::WIDTH)
+                return HasColumnRunSimd(cells, rows, cols, stride, playerChar, runLength);
+#endif
+            return HasColumnRunScalar(cells, rows, cols, stride, playerChar, runLength);
+        }
+
+        bool HasRowRunScalar(const char *cells, size_t length, char playerChar, unsigned char runLength)
+        {
+            unsigned int count = 0;
+            for (size_t i = 0; i < length; ++i)
+            {
+                if (cells[i] == playerChar)
+                {
+                    if (++count >= runLength)
+                        return true;
+                }
+                else
+                {
+                    count = 0;
+                }
+            }
+            return false;
+        }
+
+        bool HasColumnRunScalar(const char *cells, unsigned char rows, unsigned char cols, size_t stride, char playerChar, unsigned char runLength)
+        {
+            // Walk the rows in memory order and keep one counter per column.
+            unsigned char counts[256] = {};
+            for (unsigned char row = 0; row < rows; ++row)
+            {
+                const char *rowCells = cells + row * stride;
+                for (unsigned char col = 0; col < cols; ++col)
+                {
+                    if (rowCells[col] == playerChar)
+                    {
+                        if (++counts[col] >= runLength)
+                            return true;
+                    }
+                    else
+                    {
+                        counts[col] = 0;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+namespace GridWorks
+{
+    // Kernels that look for runLength consecutive playerChar cells in the rows and columns of row-major storage.
+    // The vectorized versions compare 32 (AVX2) or 16 (SSE2) cells at once and find runs in the resulting bit masks.
+    // They are selected at compile time; defining GW_DISABLE_SIMD forces the scalar versions everywhere.
+    namespace RunKernels
+    {
+        // Name of the instruction set HasRowRun and HasColumnRun were compiled for.
+        const char *GetInstructionSet();
+
+        bool HasRowRun(const char *cells, size_t length, char playerChar, unsigned char runLength);
+        bool HasColumnRun(const char *cells, unsigned char rows, unsigned char cols, size_t stride, char playerChar, unsigned char runLength);
+
+        // Plain loops, used for short rows, leftover columns and as a reference for the vectorized versions.
+        bool HasRowRunScalar(const char *cells, size_t length, char playerChar, unsigned char runLength);
+        bool HasColumnRunScalar(const char *cells, unsigned char rows, unsigned char cols, size_t stride, char playerChar, unsigned char runLength);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace GridWorks
+{
+    // The 8 symmetries of a square grid (dihedral group D4).
+    // Rectangular grids only keep Identity, Rotate180, FlipHorizontal and FlipVertical.
+    enum Symmetry
+    {
+        Identity = 0,
+        // Clockwise rotations.
+        Rotate90 = 1,
+        Rotate180 = 2,
+        Rotate270 = 3,
+        // Mirror the columns.
+        FlipHorizontal = 4,
+        // Mirror the rows.
+        FlipVertical = 5,
+        // Mirror along the main diagonal.
+        Transpose = 6,
+        // Mirror along the anti-diagonal.
+        AntiTranspose = 7
+    };
+
+    constexpr unsigned char SYMMETRY_COUNT = 8;
+
+    // Result of canonicalizing a position: the smallest hash over all symmetries,
+    // and the symmetry that maps the original grid onto the canonical one.
+    struct CanonicalForm
+    {
+        uint64_t hash;
+        Symmetry symmetry;
+    };
+
+    constexpr bool IsSymmetryValid(Symmetry symmetry, unsigned char rows, unsigned char cols)
+    {
+        switch (symmetry)
+        {
+        case Symmetry::Rotate90:
+        case Symmetry::Rotate270:
+        case Symmetry::Transpose:
+        case Symmetry::AntiTranspose:
+            return rows == cols;
+        default:
+            return true;
+        }
+    }
+
+    // Where the cell (row, col) ends up once the grid is transformed by symmetry.
+    constexpr std::pair<unsigned char, unsigned char> ApplySymmetry(Symmetry symmetry, unsigned char row, unsigned char col, unsigned char rows, unsigned char cols)
+    {
+        const unsigned char lastRow = rows - 1;
+        const unsigned char lastCol = cols - 1;
+        switch (symmetry)
+        {
+        case Symmetry::Rotate90:
+            return {col, static_cast<unsigned char>(lastRow - row)};
+        case Symmetry::Rotate180:
+            return {static_cast<unsigned char>(lastRow - row), static_cast<unsigned char>(lastCol - col)};
+        case Symmetry::Rotate270:
+            return {static_cast<unsigned char>(lastCol - col), row};
+        case Symmetry::FlipHorizontal:
+            return {row, static_cast<unsigned char>(lastCol - col)};
+        case Symmetry::FlipVertical:
+            return {static_cast<unsigned char>(lastRow - row), col};
+        case Symmetry::Transpose:
+            return {col, row};
+        case Symmetry::AntiTranspose:
+            return {static_cast<unsigned char>(lastCol - col), static_cast<unsigned char>(lastRow - row)};
+        default:
+            return {row, col};
+        }
+    }
+
+    // The symmetry that undoes the given one, e.g. to map a move on the canonical grid back to the original.
+    constexpr Symmetry InverseSymmetry(Symmetry symmetry)
+    {
+        if (symmetry == Symmetry::Rotate90)
+            return Symmetry::Rotate270;
+        if (symmetry == Symmetry::Rotate270)
+            return Symmetry::Rotate90;
+        return symmetry;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "WinLineTable.h"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+namespace GridWorks
+{
+    // Constructors & Destructors
+    WinLineTable::WinLineTable(unsigned char rows, unsigned char cols, unsigned char winLength)
+        : m_Rows(rows), m_Cols(cols), m_WinLength(winLength)
+    {
+        if (winLength == 0)
+        {
+            throw std::invalid_argument("Win length must be at least 1");
+        }
+
+        // Direction steps in LineDirection order.
+        const int steps[LINE_DIRECTION_COUNT][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (unsigned char direction = 0; direction < LINE_DIRECTION_COUNT; ++direction)
+        {
+            m_DirectionStarts[direction] = m_LineCells.size() / winLength;
+            int rowStep = steps[direction][0];
+            int colStep = steps[direction][1];
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int col = 0; col < cols; ++col)
+                {
+                    int lastRow = row + (winLength - 1) * rowStep;
+                    int lastCol = col + (winLength - 1) * colStep;
+                    if (lastRow < rows && lastCol >= 0 && lastCol < cols)
+                        AddLine(row, col, rowStep, colStep);
+                }
+            }
+        }
+        m_DirectionStarts[LINE_DIRECTION_COUNT] = m_LineCells.size() / winLength;
+
+        // Count the lines through every cell, turn the counts into offsets, then fill.
+        m_CellOffsets.assign(GetCellCount() + 1, 0);
+        for (uint16_t cell : m_LineCells)
+            ++m_CellOffsets[cell + 1];
+        for (size_t cell = 0; cell < GetCellCount(); ++cell)
+            m_CellOffsets[cell + 1] += m_CellOffsets[cell];
+
+        m_CellLines.resize(m_LineCells.size());
+        m_CellLinePositions.resize(m_LineCells.size());
+        std::vector<uint32_t> next(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+        for (size_t line = 0; line < GetLineCount(); ++line)
+        {
+            std::span<const uint16_t> cells = GetLineCells(line);
+            for (size_t position = 0; position < cells.size(); ++position)
+            {
+                m_CellLinePositions[next[cells[position]]] = static_cast<uint8_t>(position);
+                m_CellLines[next[cells[position]]++] = static_cast<uint32_t>(line);
+            }
+        }
+    }
+
+    std::shared_ptr<const WinLineTable> WinLineTable::Get(unsigned char rows, unsigned char cols, unsigned char winLength)
+    {
+        static std::mutex mutex;
+        static std::map<std::tuple<unsigned char, unsigned char, unsigned char>, std::shared_ptr<const WinLineTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const WinLineTable> &table = tables[{rows, cols, winLength}];
+        if (!table)
+            table = std::make_shared<const WinLineTable>(rows, cols, winLength);
+        return table;
+    }
+
+    // Getters & Setters
+
+    unsigned char WinLineTable::GetRows() const
+    {
+        return m_Rows;
+    }
+
+    unsigned char WinLineTable::GetCols() const
+    {
+        return m_Cols;
+    }
+
+    unsigned char WinLineTable::GetWinLength() const
+    {
+        return m_WinLength;
+    }
+
+    size_t WinLineTable::GetLineCount() const
+    {
+        return m_DirectionStarts[LINE_DIRECTION_COUNT];
+    }
+
+    size_t WinLineTable::GetCellCount() const
+    {
+        return static_cast<size_t>(m_Rows) * m_Cols;
+    }
+
+    std::span<const uint16_t> WinLineTable::GetLineCells(size_t line) const
+    {
+        return {m_LineCells.data() + line * m_WinLength, m_WinLength};
+    }
+
+    std::span<const uint16_t> WinLineTable::GetAllLineCells() const
+    {
+        return {m_LineCells.data(), m_LineCells.size()};
+    }
+
+    std::pair<size_t, size_t> WinLineTable::GetDirectionRange(LineDirection direction) const
+    {
+        return {m_DirectionStarts[direction], m_DirectionStarts[direction + 1]};
+    }
+
+    std::span<const uint32_t> WinLineTable::GetLinesThrough(unsigned char row, unsigned char col) const
+    {
+        uint16_t cell = ToCell(row, col);
+        return {m_CellLines.data() + m_CellOffsets[cell], m_CellOffsets[cell + 1] - m_CellOffsets[cell]};
+    }
+
+    std::span<const uint8_t> WinLineTable::GetLinePositionsThrough(unsigned char row, unsigned char col) const
+    {
+        uint16_t cell = ToCell(row, col);
+        return {m_CellLinePositions.data() + m_CellOffsets[cell], m_CellOffsets[cell + 1] - m_CellOffsets[cell]};
+    }
+
+    // Public methods
+
+    uint16_t WinLineTable::ToCell(unsigned char row, unsigned char col) const
+    {
+        return static_cast<uint16_t>(row * m_Cols + col);
+    }
+
+    std::pair<unsigned char, unsigned char> WinLineTable::FromCell(uint16_t cell) const
+    {
+        return {static_cast<unsigned char>(cell / m_Cols), static_cast<unsigned char>(cell % m_Cols)};
+    }
+
+    // Private methods
+
+    void WinLineTable::AddLine(int row, int col, int rowStep, int colStep)
+    {
+        for (int i = 0; i < m_WinLength; ++i)
+            m_LineCells.push_back(ToCell(static_cast<unsigned char>(row + i * rowStep), static_cast<unsigned char>(col + i * colStep)));
+    }
+}
\ No newline at end of file
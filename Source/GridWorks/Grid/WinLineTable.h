@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace GridWorks
+{
+    // Allocator that starts every buffer on its own cache line.
+    template <typename T>
+    struct CacheAlignedAllocator
+    {
+        using value_type = T;
+        static constexpr std::align_val_t ALIGNMENT{64};
+
+        CacheAlignedAllocator() = default;
+        template <typename U>
+        CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {}
+
+        T *allocate(size_t count) { return static_cast<T *>(::operator new(count * sizeof(T), ALIGNMENT)); }
+        void deallocate(T *pointer, size_t) { ::operator delete(pointer, ALIGNMENT); }
+
+        template <typename U>
+        bool operator==(const CacheAlignedAllocator<U> &) const { return true; }
+    };
+
+    // Direction a win line runs in; lines in the table are grouped by it in this order.
+    enum LineDirection
+    {
+        Horizontal = 0,
+        Vertical = 1,
+        Diagonal = 2,
+        AntiDiagonal = 3
+    };
+
+    constexpr unsigned char LINE_DIRECTION_COUNT = 4;
+
+    // Every line of winLength cells on a rows x cols grid, and for every cell the lines passing through it.
+    // Cells are identified by row * cols + col. Both lists are flat arrays (the per-cell list in CSR form)
+    // so walking them touches as few cache lines as possible.
+    // Tables are immutable and shared: Get hands out the same instance to every game with the same shape.
+    class WinLineTable
+    {
+    private:
+        unsigned char m_Rows;
+        unsigned char m_Cols;
+        unsigned char m_WinLength;
+        // Cells of line i are m_LineCells[i * winLength, (i + 1) * winLength), in walking order.
+        std::vector<uint16_t, CacheAlignedAllocator<uint16_t>> m_LineCells;
+        // First line of every direction, plus the total line count at the end.
+        size_t m_DirectionStarts[LINE_DIRECTION_COUNT + 1] = {};
+        // Lines through cell c are m_CellLines[m_CellOffsets[c], m_CellOffsets[c + 1]).
+        std::vector<uint32_t, CacheAlignedAllocator<uint32_t>> m_CellOffsets;
+        std::vector<uint32_t, CacheAlignedAllocator<uint32_t>> m_CellLines;
+        // Index of the cell within each of those lines, in the same order.
+        std::vector<uint8_t, CacheAlignedAllocator<uint8_t>> m_CellLinePositions;
+
+    public:
+        // Constructors & Destructors
+        WinLineTable(unsigned char rows, unsigned char cols, unsigned char winLength);
+
+        // Returns the cached table for the shape, building it on first use. Thread safe.
+        static std::shared_ptr<const WinLineTable> Get(unsigned char rows, unsigned char cols, unsigned char winLength);
+
+        // Getters & Setters
+    public:
+        unsigned char GetRows() const;
+        unsigned char GetCols() const;
+        unsigned char GetWinLength() const;
+
+        size_t GetLineCount() const;
+        size_t GetCellCount() const;
+
+        std::span<const uint16_t> GetLineCells(size_t line) const;
+        // Cells of every line back to back, winLength per line; for loops that visit all lines.
+        std::span<const uint16_t> GetAllLineCells() const;
+        // Range [first, last) of the lines running in direction.
+        std::pair<size_t, size_t> GetDirectionRange(LineDirection direction) const;
+        std::span<const uint32_t> GetLinesThrough(unsigned char row, unsigned char col) const;
+        // Where the cell sits in each line of GetLinesThrough, from 0 to winLength - 1.
+        std::span<const uint8_t> GetLinePositionsThrough(unsigned char row, unsigned char col) const;
+
+        // Public methods
+    public:
+        uint16_t ToCell(unsigned char row, unsigned char col) const;
+        std::pair<unsigned char, unsigned char> FromCell(uint16_t cell) const;
+
+        // Private methods
+    private:
+        void AddLine(int row, int col, int rowStep, int colStep);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Zobrist.h"
+
+#include <array>
+#include <memory>
+
+#include "Player/Moves.h"
+
+namespace GridWorks
+{
+    namespace Zobrist
+    {
+        namespace
+        {
+            // Rows and columns are unsigned chars, so 256 x 256 cells cover every grid.
+            constexpr size_t CELL_COUNT = 256 * 256;
+            constexpr size_t PIECE_COUNT = 2;
+            constexpr size_t SIDE_COUNT = 16;
+            // Odd, so every shape gets its own key.
+            constexpr uint64_t SHAPE_KEY_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+            struct KeyTables
+            {
+                std::array<uint64_t, CELL_COUNT * PIECE_COUNT> cells;
+                std::array<uint64_t, SIDE_COUNT> sides;
+            };
+
+            uint64_t SplitMix64(uint64_t &state)
+            {
+                uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+
+            const KeyTables &GetTables()
+            {
+                // Built once on first use; static initialization is thread safe.
+                static const std::unique_ptr<KeyTables> tables = []()
+                {
+                    auto result = std::make_unique<KeyTables>();
+                    uint64_t state = SEED;
+                    for (uint64_t &key : result->cells)
+                        key = SplitMix64(state);
+                    result->sides[0] = 0;
+                    for (size_t i = 1; i < SIDE_COUNT; ++i)
+                        result->sides[i] = SplitMix64(state);
+                    return result;
+                }();
+                return *tables;
+            }
+        }
+
+        uint64_t GetCellKey(unsigned char row, unsigned char col, char playerChar)
+        {
+            size_t piece;
+            if (playerChar == static_cast<char>(MoveType::X))
+                piece = 0;
+            else if (playerChar == static_cast<char>(MoveType::O))
+                piece = 1;
+            else
+                return 0;
+
+            return GetTables().cells[((static_cast<size_t>(row) << 8) | col) * PIECE_COUNT + piece];
+        }
+
+        uint64_t GetSideKey(size_t turn)
+        {
+            return GetTables().sides[turn % SIDE_COUNT];
+        }
+
+        uint64_t GetShapeKey(unsigned char rows, unsigned char cols, unsigned char winLength)
+        {
+            return (static_cast<uint64_t>(rows) << 16 | static_cast<uint64_t>(cols) << 8 | winLength) * SHAPE_KEY_MULTIPLIER;
+        }
+    }
+}
\ No newline at end of file
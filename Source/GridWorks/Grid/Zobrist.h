@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GridWorks
+{
+    // Zobrist keys for hashing grid positions.
+    // The tables are filled from a fixed seed with SplitMix64, so a position hashes to the same value on every run and machine.
+    // Cells are keyed by their absolute (row, col), so keys do not depend on the grid size.
+    namespace Zobrist
+    {
+        // Seed of the key tables; changing it invalidates every stored hash.
+        constexpr uint64_t SEED = 0x9E3779B97F4A7C15ULL;
+
+        // Key for playerChar standing on (row, col); chars that are not a MoveType hash to 0.
+        uint64_t GetCellKey(unsigned char row, unsigned char col, char playerChar);
+
+        // Key for the player whose turn it is; the first player in the turn order hashes to 0.
+        uint64_t GetSideKey(size_t turn);
+
+        // Key for the grid shape. Cell keys are the same on every grid, so tables shared across grids mix this in.
+        uint64_t GetShapeKey(unsigned char rows, unsigned char cols, unsigned char winLength);
+    }
+}
\ No newline at end of file
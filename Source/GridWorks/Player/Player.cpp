@@ -46,4 +46,14 @@ namespace GridWorks
     {
         m_MoveType = moveType;
     }
+
+    const std::optional<SearchLimits> &Player::GetSearchLimits() const
+    {
+        return m_SearchLimits;
+    }
+
+    void Player::SetSearchLimits(const SearchLimits &searchLimits)
+    {
+        m_SearchLimits = searchLimits;
+    }
 }
\ No newline at end of file
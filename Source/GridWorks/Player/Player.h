@@ -2,9 +2,12 @@
 
 #include <string>
 #include <map>
+#include <optional>
 
 #include "fmt/format.h"
 
+#include "AI/SearchLimits.h"
+
 namespace GridWorks
 {
     // Forward declarations
@@ -26,6 +29,8 @@ namespace GridWorks
         std::string m_PlayerName;
         PlayerType m_PlayerType;
         MoveType m_MoveType;
+        // Overrides GameConfiguration::searchLimits for this player's AI moves.
+        std::optional<SearchLimits> m_SearchLimits;
 
     public:
         Player(std::string playerName = "GenericName", PlayerType playerType = PlayerType::Human);
@@ -37,6 +42,8 @@ namespace GridWorks
         PlayerType GetPlayerType() const;
         MoveType GetPlayerMoveType() const;
         void SetPlayerMoveType(MoveType moveType);
+        const std::optional<SearchLimits> &GetSearchLimits() const;
+        void SetSearchLimits(const SearchLimits &searchLimits);
     };
 
 }
@@ -1,9 +1,29 @@
 #pragma once
 
 #include "Grid/Grid.h"
+#include "Grid/BitBoard.h"
+#include "Grid/Zobrist.h"
+#include "Grid/Symmetry.h"
+#include "Grid/GridPool.h"
+#include "Grid/FixedGrid.h"
+#include "Grid/WinLineTable.h"
 #include "GameLogic/GameLogic.h"
 #include "GameLogic/GameConfiguration.h"
 #include "GameLogic/GameState.h"
 #include "GameLogic/TurnManager.h"
 #include "Player/Player.h"
-#include "Player/Moves.h"
\ No newline at end of file
+#include "Player/Moves.h"
+#include "AI/Position.h"
+#include "AI/Engine.h"
+#include "AI/TranspositionTable.h"
+#include "AI/AlphaBetaEngine.h"
+#include "AI/MoveOrdering.h"
+#include "AI/MCTSEngine.h"
+#include "AI/ProofNumberSolver.h"
+#include "AI/PatternTable.h"
+#include "AI/LineCounts.h"
+#include "AI/ThreatSpaceSearch.h"
+#include "AI/OpeningBook.h"
+#include "AI/MappedFile.h"
+#include "AI/Tablebase.h"
+#include "AI/TicTacToe.h"
\ No newline at end of file
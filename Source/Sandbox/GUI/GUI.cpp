@@ -124,19 +124,24 @@ namespace GWSandbox
         }
 
         // Iterate over the grid state and draw 'X' or 'O' as needed
+        const GridWorks::GridView view = i_instance->i_gameLogic->GetGrid()->GetGrid();
+        const char xChar = GridWorks::MoveTypeEnumToChar(GridWorks::MoveType::X);
+        const char oChar = GridWorks::MoveTypeEnumToChar(GridWorks::MoveType::O);
+        const char defaultChar = i_instance->i_gameLogic->GetGrid()->GetDefaultChar();
         for (int i = 0; i < i_instance->m_gridSize; i++)
         {
+            const char *cells = view[i];
             for (int j = 0; j < i_instance->m_gridSize; j++)
             {
-                if (i_instance->i_gameLogic->GetGrid()->GetCharAt(i, j) == GridWorks::MoveTypeEnumToChar(GridWorks::MoveType::X))
+                if (cells[j] == xChar)
                 {
                     i_instance->DrawX(i, j);
                 }
-                else if (i_instance->i_gameLogic->GetGrid()->GetCharAt(i, j) == GridWorks::MoveTypeEnumToChar(GridWorks::MoveType::O))
+                else if (cells[j] == oChar)
                 {
                     i_instance->DrawO(i, j);
                 }
-                else if (i_instance->i_gameLogic->GetGrid()->GetCharAt(i, j) == i_instance->i_gameLogic->GetGrid()->GetDefaultChar())
+                else if (cells[j] == defaultChar)
                 {
                     // Do nothing
                 }
@@ -146,6 +151,18 @@ namespace GWSandbox
                 }
             }
         }
+
+        // Highlight the line that won the game.
+        if (i_instance->i_gameLogic->GetGameState() == GridWorks::GameState::GameOver && i_instance->i_gameLogic->GetGameOverType() == GridWorks::GameOverType::Win)
+        {
+            const GridWorks::Grid *grid = i_instance->i_gameLogic->GetGrid();
+            auto [lastRow, lastCol] = grid->GetLastChangedChar();
+            for (uint16_t cell : grid->GetWinningLine(lastRow, lastCol))
+            {
+                auto [row, col] = grid->GetWinLines().FromCell(cell);
+                DrawRectangle(xOffset + col * i_instance->m_cellSize, yOffset + row * i_instance->m_cellSize, i_instance->m_cellSize, i_instance->m_cellSize, Fade(GREEN, 0.3f));
+            }
+        }
     }
 
     Vector2 GUI::GetCellFromMouse(Vector2 mousePosition)
@@ -227,7 +244,10 @@ namespace GWSandbox
         unsigned char dimensions = static_cast<unsigned char>(DURLIB::GIBI(3, 10));
         m_gridSize = dimensions;
 
-        i_instance->i_gameLogic->GetGameConfiguration()->grid->ResetGridWithNewSize(dimensions, dimensions, '.');
+        GridWorks::Grid *grid = i_instance->i_gameLogic->GetGameConfiguration()->grid;
+        grid->ResetGridWithNewSize(dimensions, dimensions, '.');
+        // A smaller grid cannot fit the configured win length.
+        grid->SetWinLength(std::min(i_instance->i_gameLogic->GetGameConfiguration()->winLength, dimensions));
     }
 
     void GUI::ChangeTurnOrder()
@@ -386,7 +406,11 @@ namespace GWSandbox
             i_instance->m_windowResolution.width = GetScreenWidth();
             i_instance->m_windowResolution.height = GetScreenHeight();
             // Update
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && i_instance->i_gameLogic->GetGameState() != GridWorks::GameState::GameOver)
+            if (i_instance->i_gameLogic->IsAITurn())
+            {
+                i_instance->i_gameLogic->MakeAIMove();
+            }
+            else if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && i_instance->i_gameLogic->GetGameState() != GridWorks::GameState::GameOver)
             {
                 Vector2 cell = GetCellFromMouse(GetMousePosition());
 
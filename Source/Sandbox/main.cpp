@@ -9,14 +9,28 @@ int main(void)
     GWSandbox::GUI::Initialize();
     GWSandbox::GUI *gui = GWSandbox::GUI::GetInstance();
 
+    int opponent = 0;
+    while (opponent == 0)
+    {
+        CLI_TRACE("\n1. Human vs Human\n2. Human vs AI (alpha-beta)\n3. Human vs AI (Monte Carlo)");
+        opponent = DURLIB::GIBI(1, 3);
+    }
+
     GridWorks::Player *p1 = new GridWorks::Player("Player1", GridWorks::PlayerType::Human);
-    GridWorks::Player *p2 = new GridWorks::Player("Player2", GridWorks::PlayerType::Human);
+    GridWorks::Player *p2 = new GridWorks::Player(opponent != 1 ? "Computer" : "Player2", opponent != 1 ? GridWorks::PlayerType::AI : GridWorks::PlayerType::Human);
+    if (opponent == 3)
+    {
+        GridWorks::GameLogic::GetInstance()->SetEngine(std::make_unique<GridWorks::MCTSEngine>());
+    }
 
     unsigned char dimensions = 3;
 
     CLI_TRACE("Input the dimensions of the grid (3-10): ");
     dimensions = static_cast<unsigned char>(DURLIB::GIBI(3, 10));
 
+    CLI_TRACE("Input the amount of marks in a row needed to win (3-{0}): ", dimensions);
+    unsigned char winLength = static_cast<unsigned char>(DURLIB::GIBI(3, dimensions));
+
     int choice = 0;
     while (choice == 0)
     {
@@ -33,6 +47,7 @@ int main(void)
                                       .setGameName("TicTacToe")
                                       .setGameDescription("TicTacToe Game")
                                       .setGrid(dimensions, dimensions, '.')
+                                      .setWinLength(winLength)
                                       .setMaxPlayers(2)
                                       .addPlayer(p1)
                                       .addPlayer(p2)
@@ -47,6 +62,7 @@ int main(void)
                                       .setGameName("TicTacToe")
                                       .setGameDescription("TicTacToe Game")
                                       .setGrid(dimensions, dimensions, '.')
+                                      .setWinLength(winLength)
                                       .setMaxPlayers(2)
                                       .addPlayer(p2)
                                       .addPlayer(p1)
@@ -59,6 +75,7 @@ int main(void)
                                       .setGameName("TicTacToe")
                                       .setGameDescription("TicTacToe Game")
                                       .setGrid(dimensions, dimensions, '.')
+                                      .setWinLength(winLength)
                                       .setMaxPlayers(2)
                                       .addPlayer(p1)
                                       .addPlayer(p2)
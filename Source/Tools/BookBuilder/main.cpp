@@ -0,0 +1,105 @@
+#include <gridworks.h>
+
+#include <durlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+// Builds an opening book for one grid shape.
+//   search:   every position up to the given ply, up to symmetry, gets the alpha-beta engine's move.
+//   selfplay: the Monte Carlo engine plays games against itself and every move up to the given ply is counted.
+static void PrintUsage()
+{
+    CLI_TRACE("Usage: BookBuilder <output> <rows> <cols> <win length> <plies> [search|selfplay] [milliseconds per move] [games]");
+}
+
+static void AddSearched(GridWorks::OpeningBookBuilder &builder, GridWorks::Engine &engine, GridWorks::Position &position, size_t plies,
+                        const GridWorks::SearchLimits &limits)
+{
+    if (position.GetPly() >= plies || builder.Contains(position))
+        return;
+
+    GridWorks::SearchResult result = engine.Search(position, limits);
+    builder.Add(position, result.bestMove, result.score);
+    if (builder.GetPositionCount() % 1000 == 0)
+    {
+        CLI_TRACE("{0} positions.", builder.GetPositionCount());
+    }
+
+    std::vector<GridWorks::Move> moves;
+    position.GenerateMoves(moves);
+    for (const GridWorks::Move &move : moves)
+    {
+        position.MakeMove(move);
+        if (!position.IsLastMoveWin() && !position.IsFull())
+            AddSearched(builder, engine, position, plies, limits);
+        position.UnmakeMove();
+    }
+}
+
+static void AddSelfPlay(GridWorks::OpeningBookBuilder &builder, GridWorks::Engine &engine, const GridWorks::Position &start, size_t plies,
+                        const GridWorks::SearchLimits &limits, size_t games)
+{
+    for (size_t game = 0; game < games; ++game)
+    {
+        GridWorks::Position position = start;
+        while (position.GetPly() < plies)
+        {
+            GridWorks::SearchResult result = engine.Search(position, limits);
+            builder.Add(position, result.bestMove, result.score);
+            position.MakeMove(result.bestMove);
+            if (position.IsLastMoveWin() || position.IsFull())
+                break;
+        }
+        CLI_TRACE("Game {0}/{1}: {2} positions.", game + 1, games, builder.GetPositionCount());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    DURLIB::Log::Init();
+
+    if (argc < 6)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string output = argv[1];
+    const int rows = std::atoi(argv[2]);
+    const int cols = std::atoi(argv[3]);
+    const int winLength = std::atoi(argv[4]);
+    const int plies = std::atoi(argv[5]);
+    const std::string mode = argc > 6 ? argv[6] : "search";
+    const double milliseconds = argc > 7 ? std::atof(argv[7]) : 100.0;
+    const int games = argc > 8 ? std::atoi(argv[8]) : 100;
+    if (rows < 1 || rows > 255 || cols < 1 || cols > 255 || winLength < 1 || winLength > std::max(rows, cols) || plies < 1 ||
+        (mode != "search" && mode != "selfplay"))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    GridWorks::Grid grid(static_cast<unsigned char>(rows), static_cast<unsigned char>(cols), '.');
+    grid.SetWinLength(static_cast<unsigned char>(winLength));
+    GridWorks::Position position(grid, {'X', 'O'});
+    GridWorks::SearchLimits limits{0, 0, milliseconds};
+    GridWorks::OpeningBookBuilder builder;
+
+    if (mode == "search")
+    {
+        GridWorks::AlphaBetaEngine engine(std::make_shared<GridWorks::TranspositionTable>(64));
+        AddSearched(builder, engine, position, static_cast<size_t>(plies), limits);
+    }
+    else
+    {
+        GridWorks::MCTSEngine engine;
+        AddSelfPlay(builder, engine, position, static_cast<size_t>(plies), limits, static_cast<size_t>(games));
+    }
+
+    if (!builder.Write(output))
+        return 1;
+    CLI_TRACE("Wrote {0} positions to {1}.", builder.GetPositionCount(), output);
+    return 0;
+}
\ No newline at end of file
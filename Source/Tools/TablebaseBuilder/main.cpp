@@ -0,0 +1,97 @@
+#include <gridworks.h>
+
+#include <durlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+// Generates a tablebase for one grid shape, or checks one against the df-pn solver.
+//   generate: solves every position by retrograde analysis and writes the table.
+//   verify:   plays random games to a random ply and compares the tablebase value with a solve of the position.
+static void PrintUsage()
+{
+    CLI_TRACE("Usage: TablebaseBuilder generate <output> <rows> <cols> <win length> [threads]");
+    CLI_TRACE("       TablebaseBuilder verify <tablebase> [positions] [seed]");
+}
+
+static int Generate(int argc, char **argv)
+{
+    const int rows = std::atoi(argv[3]);
+    const int cols = std::atoi(argv[4]);
+    const int winLength = std::atoi(argv[5]);
+    const int threads = argc > 6 ? std::atoi(argv[6]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (rows < 1 || cols < 1 || rows * cols > static_cast<int>(GridWorks::PositionRank::MAX_CELLS) || winLength < 1 || threads < 1)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!GridWorks::Tablebase::Generate(static_cast<unsigned char>(rows), static_cast<unsigned char>(cols), static_cast<unsigned char>(winLength), argv[2],
+                                        static_cast<size_t>(threads)))
+        return 1;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CLI_TRACE("Solved {0} positions in {1:.2f} s on {2} threads.", GridWorks::PositionRank(static_cast<size_t>(rows * cols)).GetPositionCount(), seconds,
+              threads);
+    return 0;
+}
+
+static int Verify(int argc, char **argv)
+{
+    GridWorks::Tablebase tablebase;
+    if (!tablebase.Open(argv[2]))
+        return 1;
+    const int positions = argc > 3 ? std::atoi(argv[3]) : 1000;
+    std::mt19937 random(argc > 4 ? static_cast<unsigned int>(std::atoi(argv[4])) : 1);
+
+    GridWorks::Grid grid(tablebase.GetRows(), tablebase.GetCols(), '.');
+    grid.SetWinLength(tablebase.GetWinLength());
+    GridWorks::ProofNumberSolver solver;
+    int mismatches = 0;
+    for (int sample = 0; sample < positions; ++sample)
+    {
+        GridWorks::Position position(grid, {'X', 'O'});
+        const size_t plies = random() % grid.GetCellCount();
+        std::vector<GridWorks::Move> moves;
+        while (position.GetPly() < plies)
+        {
+            position.GenerateMoves(moves);
+            position.MakeMove(moves[random() % moves.size()]);
+            moves.clear();
+            if (position.IsLastMoveWin() || position.IsFull())
+                break;
+        }
+
+        GridWorks::ProofValue expected = GridWorks::ProvenLoss;
+        if (!position.IsLastMoveWin())
+            expected = position.IsFull() ? GridWorks::ProvenDraw : solver.Solve(position).value;
+        const GridWorks::ProofValue value = tablebase.GetValue(position);
+        if (value != expected)
+        {
+            CLI_ERROR("Position {0} after {1} plies: tablebase says {2}, the solver {3}.", sample, position.GetPly(), static_cast<int>(value),
+                      static_cast<int>(expected));
+            ++mismatches;
+        }
+    }
+
+    CLI_TRACE("{0} of {1} positions match.", positions - mismatches, positions);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    DURLIB::Log::Init();
+
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "generate" && argc >= 6)
+        return Generate(argc, argv);
+    if (mode == "verify" && argc >= 3)
+        return Verify(argc, argv);
+
+    PrintUsage();
+    return 1;
+}
\ No newline at end of file
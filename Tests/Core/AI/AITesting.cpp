@@ -0,0 +1,1009 @@
+#include <gtest/gtest.h>
+#include "AI/AlphaBetaEngine.h"
+#include "AI/LineCounts.h"
+#include "AI/MCTSEngine.h"
+#include "AI/MoveOrdering.h"
+#include "AI/OpeningBook.h"
+#include "AI/PatternTable.h"
+#include "AI/Position.h"
+#include "AI/ProofNumberSolver.h"
+#include "AI/Tablebase.h"
+#include "AI/TicTacToe.h"
+#include "AI/ThreatSpaceSearch.h"
+#include "AI/TranspositionTable.h"
+#include "Grid/Grid.h"
+#include "Grid/Zobrist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <durlib.h>
+
+namespace GridWorks
+{
+    class PositionTest : public ::testing::Test
+    {
+    protected:
+        Grid *grid;
+
+        void SetUp() override
+        {
+            grid = new Grid(3, 3, '.');
+        }
+
+        void TearDown() override
+        {
+            delete grid;
+        }
+    };
+
+    TEST_F(PositionTest, MakeMovePassesTheTurn)
+    {
+        Position position(*grid, {'X', 'O'});
+        EXPECT_EQ(position.GetSideToMoveChar(), 'X');
+
+        position.MakeMove(1, 1);
+        EXPECT_EQ(position.GetGrid().GetCharAt(1, 1), 'X');
+        EXPECT_EQ(position.GetSideToMoveChar(), 'O');
+        EXPECT_EQ(position.GetPly(), 1);
+        EXPECT_EQ(position.GetLastMove(), (Move{1, 1}));
+        EXPECT_EQ(position.GetHash(), Zobrist::GetCellKey(1, 1, 'X') ^ Zobrist::GetSideKey(1));
+
+        // The source grid is not touched.
+        EXPECT_EQ(grid->GetCharAt(1, 1), '.');
+        EXPECT_FALSE(position.IsLegalMove(1, 1));
+        EXPECT_FALSE(position.IsLegalMove(3, 0));
+    }
+
+    TEST_F(PositionTest, UnmakeMoveRestoresEverything)
+    {
+        grid->SetCharAt(0, 2, 'O');
+        Position position(*grid, {'X', 'O'});
+
+        uint64_t hash = position.GetHash();
+        CanonicalForm canonical = position.GetGrid().GetCanonicalForm();
+        size_t occupied = position.GetGrid().GetOccupiedCount();
+
+        position.MakeMove(2, 0);
+        position.MakeMove(1, 1);
+        position.UnmakeMove();
+        position.UnmakeMove();
+
+        EXPECT_EQ(position.GetGrid().GetCharAt(2, 0), '.');
+        EXPECT_EQ(position.GetGrid().GetCharAt(1, 1), '.');
+        EXPECT_EQ(position.GetHash(), hash);
+        EXPECT_EQ(position.GetGrid().GetCanonicalForm().hash, canonical.hash);
+        EXPECT_EQ(position.GetGrid().GetOccupiedCount(), occupied);
+        EXPECT_EQ(position.GetLastMove(), (Move{0, 2}));
+        EXPECT_EQ(position.GetSideToMove(), 0);
+        EXPECT_EQ(position.GetPly(), 0);
+        EXPECT_FALSE(position.GetGrid().GetBitBoard().Test(1, 1, 'X'));
+    }
+
+    TEST_F(PositionTest, LastMoveWin)
+    {
+        Position position(*grid, {'X', 'O'});
+        position.MakeMove(0, 0);
+        position.MakeMove(1, 0);
+        position.MakeMove(0, 1);
+        position.MakeMove(1, 1);
+        EXPECT_FALSE(position.IsLastMoveWin());
+
+        position.MakeMove(0, 2);
+        EXPECT_TRUE(position.IsLastMoveWin());
+
+        position.UnmakeMove();
+        position.MakeMove(2, 2);
+        EXPECT_FALSE(position.IsLastMoveWin());
+    }
+
+    // Walk random lines of play forward and back, and check that each ply restores the hash it started from.
+    TEST_F(PositionTest, RandomMakeUnmakeRoundTrip)
+    {
+        std::mt19937 rng(7);
+        Grid big(7, 7, '.');
+        Position position(big, {'X', 'O'});
+        std::vector<Move> moves;
+
+        for (int game = 0; game < 200; ++game)
+        {
+            std::vector<uint64_t> hashes;
+            while (!position.IsFull() && !position.IsLastMoveWin())
+            {
+                moves.clear();
+                position.GenerateMoves(moves);
+                EXPECT_EQ(moves.size(), big.GetCellCount() - position.GetGrid().GetOccupiedCount());
+
+                hashes.push_back(position.GetHash());
+                position.MakeMove(moves[rng() % moves.size()]);
+            }
+            while (position.GetPly() > 0)
+            {
+                position.UnmakeMove();
+                EXPECT_EQ(position.GetHash(), hashes.back());
+                hashes.pop_back();
+            }
+            EXPECT_EQ(position.GetGrid().GetOccupiedCount(), 0);
+        }
+    }
+
+    // Builds a position from rows of chars, with X to move unless stated otherwise.
+    static Position MakePosition(const std::vector<std::string> &rows, size_t sideToMove = 0, unsigned char winLength = 3)
+    {
+        Grid grid(static_cast<unsigned char>(rows.size()), static_cast<unsigned char>(rows[0].size()), '.');
+        grid.SetWinLength(winLength);
+        for (unsigned char row = 0; row < rows.size(); ++row)
+            for (unsigned char col = 0; col < rows[row].size(); ++col)
+                grid.SetCharAt(row, col, rows[row][col]);
+        return Position(grid, {'X', 'O'}, sideToMove);
+    }
+
+    class AlphaBetaEngineTest : public ::testing::Test
+    {
+    protected:
+        AlphaBetaEngine engine;
+    };
+
+    TEST_F(AlphaBetaEngineTest, EmptyBoardIsADraw)
+    {
+        Position position = MakePosition({"...", "...", "..."});
+        SearchResult result = engine.Search(position, SearchLimits());
+        EXPECT_EQ(result.score, 0);
+        EXPECT_EQ(result.stats.depth, 9);
+        EXPECT_EQ(position.GetPly(), 0);
+        EXPECT_EQ(position.GetGrid().GetOccupiedCount(), 0);
+    }
+
+    TEST_F(AlphaBetaEngineTest, TakesTheWin)
+    {
+        Position position = MakePosition({"XX.", "OO.", "..."});
+        SearchResult result = engine.Search(position, SearchLimits());
+        EXPECT_EQ(result.bestMove, (Move{0, 2}));
+        EXPECT_EQ(result.score, WIN_SCORE - 1);
+    }
+
+    TEST_F(AlphaBetaEngineTest, BlocksTheOpponent)
+    {
+        Position position = MakePosition({"X..", ".X.", "O.."}, 1);
+        SearchResult result = engine.Search(position, SearchLimits());
+        EXPECT_EQ(result.bestMove, (Move{2, 2}));
+    }
+
+    TEST_F(AlphaBetaEngineTest, FindsForcedWinOnLargerBoard)
+    {
+        // X makes an open three on 5x5 with four in a row to win; either end wins next move.
+        Position position = MakePosition({".....", ".XXX.", "..O..", ".O...", "....O"}, 0, 4);
+        SearchResult result = engine.Search(position, SearchLimits{3, 0});
+        EXPECT_EQ(result.score, WIN_SCORE - 1);
+        EXPECT_TRUE(result.bestMove == (Move{1, 0}) || result.bestMove == (Move{1, 4}));
+    }
+
+    TEST_F(AlphaBetaEngineTest, RespectsNodeLimit)
+    {
+        Position position = MakePosition({".......", ".......", ".......", ".......", ".......", ".......", "......."});
+        SearchResult result = engine.Search(position, SearchLimits{0, 1000});
+        EXPECT_LE(result.stats.nodes, 1000);
+        EXPECT_TRUE(position.IsLegalMove(result.bestMove.row, result.bestMove.col));
+        EXPECT_EQ(position.GetPly(), 0);
+    }
+
+    TEST_F(AlphaBetaEngineTest, KeepsLastCompletedDepth)
+    {
+        Position position = MakePosition({".......", ".......", ".......", ".......", ".......", ".......", "......."});
+        SearchResult result = engine.Search(position, SearchLimits{0, 5000});
+        EXPECT_GE(result.stats.depth, 2);
+        EXPECT_LT(result.stats.depth, 49);
+        EXPECT_TRUE(position.IsLegalMove(result.bestMove.row, result.bestMove.col));
+    }
+
+    TEST_F(AlphaBetaEngineTest, RespectsTimeBudget)
+    {
+        Grid grid(64, 64, '.');
+        grid.SetWinLength(5);
+        Position position(grid, {'X', 'O'});
+        SearchResult result = engine.Search(position, SearchLimits{0, 0, 20.0});
+        // Generous slack for loaded machines; without the budget this search would run for hours.
+        EXPECT_LT(result.stats.elapsedMilliseconds, 500.0);
+        EXPECT_TRUE(position.IsLegalMove(result.bestMove.row, result.bestMove.col));
+        EXPECT_EQ(position.GetPly(), 0);
+    }
+
+    TEST_F(AlphaBetaEngineTest, StopsOnCancel)
+    {
+        std::atomic<bool> stop{true};
+        Position position = MakePosition({"...", "...", "..."});
+        SearchResult result = engine.Search(position, SearchLimits{0, 0, 0.0, &stop});
+        EXPECT_LE(result.stats.nodes, 1);
+        EXPECT_EQ(result.stats.depth, 0);
+        EXPECT_TRUE(position.IsLegalMove(result.bestMove.row, result.bestMove.col));
+    }
+
+    TEST_F(AlphaBetaEngineTest, TranspositionTableKeepsScoreAndSavesNodes)
+    {
+        AlphaBetaEngine tableEngine(std::make_shared<TranspositionTable>(1));
+        Position position = MakePosition({"....", "....", "....", "...."});
+        SearchResult plain = engine.Search(position, SearchLimits{6, 0});
+        SearchResult cached = tableEngine.Search(position, SearchLimits{6, 0});
+        EXPECT_EQ(cached.score, plain.score);
+        EXPECT_LT(cached.stats.nodes, plain.stats.nodes);
+        EXPECT_GT(tableEngine.GetTranspositionTable()->GetStats().hits, 0);
+    }
+
+    TEST_F(AlphaBetaEngineTest, SharedTableKeepsGridShapesApart)
+    {
+        // Cell keys are the same on every grid, so the 3x3 entries must not answer the 5x5 searches.
+        AlphaBetaEngine shared(std::make_shared<TranspositionTable>(1));
+        Position small = MakePosition({"X..", "...", "..."}, 1);
+        shared.Search(small, SearchLimits{8, 0});
+
+        for (unsigned char winLength : {3, 4})
+        {
+            Position position = MakePosition({"X....", ".....", ".....", ".....", "....."}, 1, winLength);
+            AlphaBetaEngine fresh(std::make_shared<TranspositionTable>(1));
+            SearchResult expected = fresh.Search(position, SearchLimits{2, 0});
+            SearchResult result = shared.Search(position, SearchLimits{2, 0});
+            EXPECT_EQ(result.score, expected.score);
+            EXPECT_EQ(result.bestMove, expected.bestMove);
+        }
+    }
+
+    TEST_F(AlphaBetaEngineTest, LazySMPAgreesWithSingleThread)
+    {
+        AlphaBetaEngine parallel(std::make_shared<TranspositionTable>(1), 4);
+        Position empty = MakePosition({"...", "...", "..."});
+        SearchResult result = parallel.Search(empty, SearchLimits());
+        EXPECT_EQ(result.score, 0);
+        EXPECT_EQ(result.stats.depth, 9);
+        EXPECT_EQ(empty.GetPly(), 0);
+
+        Position winning = MakePosition({".....", ".XXX.", "..O..", ".O...", "....O"}, 0, 4);
+        result = parallel.Search(winning, SearchLimits{3, 0});
+        EXPECT_EQ(result.score, WIN_SCORE - 1);
+        EXPECT_TRUE(result.bestMove == (Move{1, 0}) || result.bestMove == (Move{1, 4}));
+    }
+
+    // Line counts updated move by move must give the same features, and the same score, as a rescan of the grid.
+    TEST_F(AlphaBetaEngineTest, IncrementalEvaluationMatchesRescan)
+    {
+        auto rescan = [](const Position &position)
+        {
+            const WinLineTable &lines = position.GetGrid().GetWinLines();
+            const char own = position.GetSideToMoveChar();
+            const char opponent = position.GetPlayerChar(1 - position.GetSideToMove());
+            int64_t score = 0;
+            for (size_t line = 0; line < lines.GetLineCount(); ++line)
+            {
+                int ownCount = 0;
+                int opponentCount = 0;
+                for (uint16_t cell : lines.GetLineCells(line))
+                {
+                    auto [row, col] = lines.FromCell(cell);
+                    ownCount += position.GetGrid().GetCharAt(row, col) == own;
+                    opponentCount += position.GetGrid().GetCharAt(row, col) == opponent;
+                }
+                if (ownCount > 0 && opponentCount == 0)
+                    score += 1LL << std::min(3 * ownCount, 30);
+                else if (opponentCount > 0 && ownCount == 0)
+                    score -= 1LL << std::min(3 * opponentCount, 30);
+            }
+            return static_cast<int>(std::clamp<int64_t>(score, -WIN_THRESHOLD / 2, WIN_THRESHOLD / 2));
+        };
+        auto expectSameCounts = [](const LineCounts &incremental, const Position &position)
+        {
+            LineCounts fresh;
+            fresh.Reset(position);
+            for (size_t side = 0; side < 2; ++side)
+            {
+                EXPECT_EQ(incremental.GetOpenLineCount(side), fresh.GetOpenLineCount(side));
+                for (size_t stones = 0; stones <= position.GetGrid().GetWinLength(); ++stones)
+                    EXPECT_EQ(incremental.GetOpenLineCount(side, stones), fresh.GetOpenLineCount(side, stones));
+            }
+            ASSERT_EQ(incremental.HasPatterns(), fresh.HasPatterns());
+            if (!fresh.HasPatterns())
+                return;
+            EXPECT_EQ(incremental.GetPatternScore(), fresh.GetPatternScore());
+            for (size_t line = 0; line < fresh.GetLineCount(); ++line)
+            {
+                EXPECT_EQ(incremental.GetPattern(line).pattern, fresh.GetPattern(line).pattern);
+                EXPECT_EQ(incremental.GetPattern(line).emptyMask, fresh.GetPattern(line).emptyMask);
+            }
+        };
+
+        std::mt19937 random(11);
+        // Four to win has a pattern table, nine falls back to the open line histogram.
+        for (unsigned char winLength : {4, 9})
+        {
+            Position position = MakePosition(std::vector<std::string>(9, "........."), 0, winLength);
+            LineCounts lines;
+            lines.Reset(position);
+            EXPECT_EQ(lines.HasPatterns(), winLength <= PatternTable::MAX_LENGTH);
+            std::vector<Move> moves;
+            for (int game = 0; game < 20; ++game)
+            {
+                while (!position.IsFull() && !position.IsLastMoveWin())
+                {
+                    moves.clear();
+                    position.GenerateMoves(moves);
+                    Move move = moves[random() % moves.size()];
+                    lines.Add(position.GetSideToMove(), move);
+                    position.MakeMove(move);
+                    expectSameCounts(lines, position);
+                    EXPECT_EQ(AlphaBetaEngine::Evaluate(lines, position.GetSideToMove()), rescan(position));
+                    EXPECT_EQ(AlphaBetaEngine::Evaluate(position), rescan(position));
+                }
+                while (position.GetPly() > 0)
+                {
+                    Move move = position.GetLastMove();
+                    position.UnmakeMove();
+                    lines.Remove(position.GetSideToMove(), move);
+                }
+                expectSameCounts(lines, position);
+                EXPECT_EQ(AlphaBetaEngine::Evaluate(lines, 0), 0);
+            }
+        }
+    }
+
+    TEST_F(AlphaBetaEngineTest, OrderingHeuristicsSaveNodes)
+    {
+        // Ordering never changes what a fixed depth search finds, only how much of the tree it has to see.
+        Position position = MakePosition({".....", ".....", "..X..", ".....", "....."}, 1, 4);
+        SearchResult ordered = engine.Search(position, SearchLimits{4, 0});
+        engine.SetOrderingHeuristics(false);
+        SearchResult naive = engine.Search(position, SearchLimits{4, 0});
+        EXPECT_EQ(ordered.stats.depth, 4);
+        EXPECT_EQ(naive.stats.depth, 4);
+        EXPECT_EQ(ordered.score, naive.score);
+        EXPECT_LT(ordered.stats.nodes, naive.stats.nodes);
+    }
+
+    TEST(MoveOrderingTest, OrdersTableMoveKillersHistoryThenCenter)
+    {
+        Grid grid(5, 5, '.');
+        grid.SetWinLength(4);
+        grid.SetCharAt(2, 2, 'X');
+        Position position(grid, {'X', 'O'}, 1);
+
+        MoveOrdering ordering;
+        ordering.Reset(grid);
+        auto order = [&](Move tableMove)
+        {
+            std::vector<Move> moves;
+            Move move;
+            ordering.Begin(position, 3, tableMove);
+            while (ordering.Next(position, 3, move))
+                moves.push_back(move);
+            return moves;
+        };
+        EXPECT_EQ(ordering.GetBaseOrder().front(), (Move{2, 2}));
+        ordering.RecordCutoff(1, Move{4, 4}, 3, 2);
+        ordering.RecordCutoff(1, Move{0, 4}, 3, 1);
+        ordering.RecordCutoff(1, Move{0, 0}, 5, 3);
+        // History is per side, so X's cutoffs do not move O's moves.
+        ordering.RecordCutoff(0, Move{1, 1}, 5, 4);
+        EXPECT_EQ(ordering.GetKillers(3)[0], (Move{0, 4}));
+        EXPECT_EQ(ordering.GetKillers(3)[1], (Move{4, 4}));
+        EXPECT_EQ(ordering.GetKillers(4)[0], MoveOrdering::NO_MOVE);
+        EXPECT_EQ(ordering.GetHistory(1, Move{0, 0}), 9);
+        EXPECT_EQ(ordering.GetHistory(1, Move{1, 1}), 0);
+
+        // The table move is illegal here, so killers lead, then history, then center first.
+        std::vector<Move> moves = order(Move{2, 2});
+        ASSERT_EQ(moves.size(), 24);
+        EXPECT_EQ(moves[0], (Move{0, 4}));
+        EXPECT_EQ(moves[1], (Move{4, 4}));
+        EXPECT_EQ(moves[2], (Move{0, 0}));
+        EXPECT_EQ(moves[3], (Move{1, 1}));
+
+        moves = order(Move{1, 3});
+        ASSERT_EQ(moves.size(), 24);
+        EXPECT_EQ(moves[0], (Move{1, 3}));
+        EXPECT_EQ(std::count(moves.begin(), moves.end(), Move{1, 3}), 1);
+
+        ordering.Reset(grid, false);
+        moves = order(Move{1, 3});
+        ASSERT_EQ(moves.size(), 24);
+        EXPECT_EQ(moves[0], (Move{0, 0}));
+        EXPECT_EQ(moves[12], (Move{2, 3}));
+        EXPECT_EQ(ordering.GetHistory(1, Move{0, 0}), 0);
+    }
+
+    class MCTSEngineTest : public ::testing::Test
+    {
+    protected:
+        MCTSEngine mcts;
+    };
+
+    TEST_F(MCTSEngineTest, TakesTheWin)
+    {
+        Position position = MakePosition({"XX.", "OO.", "..."});
+        SearchResult result = mcts.Search(position, SearchLimits{0, 2000});
+        EXPECT_EQ(result.bestMove, (Move{0, 2}));
+        EXPECT_GT(result.score, 900);
+    }
+
+    TEST_F(MCTSEngineTest, BlocksTheOpponent)
+    {
+        Position position = MakePosition({"X..", ".X.", "O.."}, 1);
+        SearchResult result = mcts.Search(position, SearchLimits{0, 5000});
+        EXPECT_EQ(result.bestMove, (Move{2, 2}));
+        EXPECT_EQ(position.GetPly(), 0);
+    }
+
+    TEST_F(MCTSEngineTest, ReportsIterationsAndPlayouts)
+    {
+        Position position = MakePosition({".......", ".......", ".......", ".......", ".......", ".......", "......."});
+        SearchResult result = mcts.Search(position, SearchLimits{0, 1000});
+        EXPECT_EQ(result.stats.nodes, 1000);
+        EXPECT_GT(result.stats.playouts, 0);
+        EXPECT_LE(result.stats.playouts, 1000);
+        EXPECT_GT(result.stats.depth, 0);
+        EXPECT_GT(result.stats.GetPlayoutsPerSecond(), 0.0);
+        EXPECT_EQ(mcts.GetRootVisits(), 1000);
+    }
+
+    TEST_F(MCTSEngineTest, RespectsTimeBudget)
+    {
+        Grid grid(15, 15, '.');
+        grid.SetWinLength(5);
+        Position position(grid, {'X', 'O'});
+        SearchResult result = mcts.Search(position, SearchLimits{0, 0, 20.0});
+        EXPECT_LT(result.stats.elapsedMilliseconds, 500.0);
+        EXPECT_TRUE(position.IsLegalMove(result.bestMove.row, result.bestMove.col));
+    }
+
+    TEST_F(MCTSEngineTest, ReusesSubtreeAfterReply)
+    {
+        Position position = MakePosition({".....", ".....", ".....", ".....", "....."}, 0, 4);
+        SearchResult first = mcts.Search(position, SearchLimits{0, 5000});
+        position.MakeMove(first.bestMove);
+        // Reply with the first cell the tree expands under our move, so the tree is sure to have it.
+        Move reply = position.IsLegalMove(2, 2) ? Move{2, 2} : Move{1, 1};
+        position.MakeMove(reply);
+
+        mcts.Search(position, SearchLimits{0, 1000});
+        EXPECT_GT(mcts.GetRootVisits(), 1000);
+
+        // A position the tree does not know starts over.
+        Position unrelated = MakePosition({"X....", ".....", ".....", ".....", "....O"}, 0, 4);
+        mcts.Search(unrelated, SearchLimits{0, 1000});
+        EXPECT_EQ(mcts.GetRootVisits(), 1000);
+    }
+
+    TEST_F(MCTSEngineTest, TreeParallelSharesTheIterationBudget)
+    {
+        mcts.SetThreadCount(4);
+        Position position = MakePosition({".......", ".......", ".......", ".......", ".......", ".......", "......."});
+        SearchResult result = mcts.Search(position, SearchLimits{0, 2000});
+        EXPECT_EQ(result.stats.nodes, 2000);
+        EXPECT_EQ(mcts.GetRootVisits(), 2000);
+
+        Position win = MakePosition({"XX.", "OO.", "..."});
+        result = mcts.Search(win, SearchLimits{0, 2000});
+        EXPECT_EQ(result.bestMove, (Move{0, 2}));
+    }
+
+    TEST_F(MCTSEngineTest, FullTreeStaysWithinItsCapacity)
+    {
+        // Threads keep racing for the last free nodes; none may be counted past the cap or lose its move.
+        MCTSEngine small(64);
+        small.SetThreadCount(4);
+        Position position = MakePosition({".......", ".......", ".......", ".......", ".......", ".......", "......."});
+        SearchResult result = small.Search(position, SearchLimits{0, 4000});
+        EXPECT_EQ(result.stats.nodes, 4000);
+        EXPECT_EQ(small.GetTreeSize(), 64);
+
+        // The root and its five children fill the arena exactly, so a move lost to a failed allocation would hide
+        // the win for good.
+        MCTSEngine tiny(6);
+        tiny.SetThreadCount(4);
+        Position win = MakePosition({"XX.", "OO.", "..."});
+        for (int search = 0; search < 200; ++search)
+        {
+            tiny.Reset();
+            result = tiny.Search(win, SearchLimits{0, 100});
+            EXPECT_EQ(result.bestMove, (Move{0, 2}));
+            EXPECT_EQ(tiny.GetTreeSize(), 6);
+        }
+    }
+
+    TEST_F(MCTSEngineTest, RootParallelAddsUpTheTrees)
+    {
+        mcts.SetThreadCount(4);
+        mcts.SetParallelism(RootParallel);
+        Position position = MakePosition({"X..", ".X.", "O.."}, 1);
+        SearchResult result = mcts.Search(position, SearchLimits{0, 8000});
+        EXPECT_EQ(result.bestMove, (Move{2, 2}));
+        EXPECT_EQ(result.stats.nodes, 8000);
+        EXPECT_EQ(mcts.GetRootVisits(), 8000);
+    }
+
+    class OpeningBookTest : public ::testing::Test
+    {
+    protected:
+        OpeningBookBuilder builder;
+    };
+
+    TEST_F(OpeningBookTest, RoundTrip)
+    {
+        Position empty = MakePosition({"...", "...", "..."});
+        builder.Add(empty, Move{1, 1}, 0);
+        builder.Add(empty, Move{0, 0}, 0);
+        builder.Add(empty, Move{1, 1}, 10);
+        // Stored once for all eight orientations.
+        builder.Add(MakePosition({"XO.", "...", "..."}), Move{2, 2}, 50);
+        builder.Add(MakePosition({"..X", "..O", "..."}), Move{2, 0}, 70);
+        EXPECT_EQ(builder.GetPositionCount(), 2);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "gridworks_opening_book.bin").string();
+        ASSERT_TRUE(builder.Write(path));
+        OpeningBook book;
+        ASSERT_TRUE(book.Open(path));
+        EXPECT_EQ(book.GetEntryCount(), 2);
+
+        BookEntry entry;
+        ASSERT_TRUE(book.Probe(empty, entry));
+        EXPECT_EQ(entry.moves, (std::vector<Move>{{1, 1}, {0, 0}}));
+        EXPECT_EQ(entry.score, 5);
+        EXPECT_EQ(entry.count, 3);
+
+        // The same position turned a quarter clockwise gets the move turned with it.
+        ASSERT_TRUE(book.Probe(MakePosition({"..X", "..O", "..."}), entry));
+        EXPECT_EQ(entry.moves, (std::vector<Move>{{2, 0}}));
+        EXPECT_EQ(entry.count, 2);
+        ASSERT_TRUE(book.Probe(MakePosition({"...", "...", ".OX"}), entry));
+        EXPECT_EQ(entry.moves, (std::vector<Move>{{0, 0}}));
+
+        EXPECT_FALSE(book.Probe(MakePosition({"X..", "...", "..."}, 1), entry));
+        EXPECT_FALSE(book.Probe(MakePosition({"XO.", "...", "..."}, 1), entry));
+        EXPECT_FALSE(book.Probe(MakePosition({"....", "....", "....", "...."}), entry));
+        EXPECT_THROW(builder.Add(MakePosition({"....", "....", "....", "...."}), Move{0, 0}, 0), std::invalid_argument);
+
+        book.Close();
+        EXPECT_FALSE(book.IsOpen());
+        std::filesystem::remove(path);
+        EXPECT_FALSE(book.Open(path));
+    }
+
+    class ProofNumberSolverTest : public ::testing::Test
+    {
+    protected:
+        ProofNumberSolver solver{4};
+    };
+
+    TEST_F(ProofNumberSolverTest, SolvesSmallBoards)
+    {
+        Position empty = MakePosition({"...", "...", "..."});
+        ProofResult result = solver.Solve(empty);
+        EXPECT_EQ(result.value, ProvenDraw);
+        EXPECT_EQ(result.stats.rootProof, 0);
+        EXPECT_EQ(result.stats.rootDisproof, ProofNumberSolver::INFINITE_PROOF);
+        EXPECT_GT(result.stats.proofs, 0);
+        EXPECT_GT(result.stats.disproofs, 0);
+        EXPECT_EQ(empty.GetPly(), 0);
+
+        // Three in a row on 4x4 is a first player win.
+        Position larger = MakePosition({"....", "....", "....", "...."});
+        EXPECT_EQ(solver.Solve(larger).value, ProvenWin);
+    }
+
+    TEST_F(ProofNumberSolverTest, KeepsGridShapesApart)
+    {
+        // The same stones on another shape or win length are another position, even in the same table.
+        Position winning = MakePosition({"....", "....", "....", "...."});
+        EXPECT_EQ(solver.Solve(winning).value, ProvenWin);
+        Position drawn = MakePosition({"....", "....", "....", "...."}, 0, 4);
+        EXPECT_EQ(solver.Solve(drawn).value, ProvenDraw);
+        Position smaller = MakePosition({"...", "...", "..."});
+        EXPECT_EQ(solver.Solve(smaller).value, ProvenDraw);
+    }
+
+    TEST_F(ProofNumberSolverTest, ProvesWinsAndLosses)
+    {
+        Position win = MakePosition({"XX.", "OO.", "..."});
+        ProofResult result = solver.Solve(win);
+        EXPECT_EQ(result.value, ProvenWin);
+        EXPECT_EQ(result.bestMove, (Move{0, 2}));
+
+        // X threatens three lines at once.
+        Position loss = MakePosition({"XOO", "XX.", "..."}, 1);
+        EXPECT_EQ(solver.Solve(loss).value, ProvenLoss);
+    }
+
+    TEST_F(ProofNumberSolverTest, ResumesFromCheckpoint)
+    {
+        Position position = MakePosition({"....", "....", "....", "...."}, 0, 4);
+        ProofResult fresh = ProofNumberSolver(4).Solve(position);
+        ASSERT_EQ(fresh.value, ProvenDraw);
+
+        // Stop halfway, then carry on from a checkpoint in a new solver.
+        const uint64_t halfway = fresh.stats.nodes / 2;
+        ProofResult partial = solver.Solve(position, SearchLimits{0, halfway});
+        EXPECT_EQ(partial.value, Unproven);
+        EXPECT_LE(partial.stats.nodes, halfway);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "gridworks_proof_checkpoint.bin").string();
+        ASSERT_TRUE(solver.SaveCheckpoint(path));
+        ProofNumberSolver resumed(1);
+        ASSERT_TRUE(resumed.LoadCheckpoint(path));
+        EXPECT_EQ(resumed.GetEntryCount(), solver.GetEntryCount());
+        std::filesystem::remove(path);
+
+        ProofResult result = resumed.Solve(position);
+        EXPECT_EQ(result.value, ProvenDraw);
+        EXPECT_LT(result.stats.nodes, fresh.stats.nodes);
+
+        EXPECT_FALSE(resumed.LoadCheckpoint(path));
+    }
+
+    TEST(PositionRankTest, RanksArePerfect)
+    {
+        // Every 3x3 placement with the first player level or one stone ahead, once.
+        PositionRank rank(9);
+        EXPECT_EQ(rank.GetPositionCount(), 6046);
+        for (uint64_t i = 0; i < rank.GetPositionCount(); ++i)
+        {
+            uint32_t first = 0;
+            uint32_t second = 0;
+            rank.Unrank(i, first, second);
+            EXPECT_EQ(first & second, 0u);
+            ASSERT_EQ(rank.Rank(first, second), i);
+        }
+        EXPECT_EQ(PositionRank(16).GetPositionCount(), 10165779);
+        EXPECT_THROW(PositionRank(26), std::invalid_argument);
+    }
+
+    class TablebaseTest : public ::testing::Test
+    {
+    protected:
+        const std::string path = (std::filesystem::temp_directory_path() / "gridworks_tablebase.bin").string();
+    };
+
+    TEST_F(TablebaseTest, MatchesSolver)
+    {
+        ProofNumberSolver solver{4};
+        std::mt19937 random(7);
+        for (auto [rows, cols] : {std::pair{3, 3}, {3, 4}})
+        {
+            ASSERT_TRUE(Tablebase::Generate(static_cast<unsigned char>(rows), static_cast<unsigned char>(cols), 3, path, 2));
+            Tablebase tablebase;
+            ASSERT_TRUE(tablebase.Open(path));
+
+            Grid grid(static_cast<unsigned char>(rows), static_cast<unsigned char>(cols), '.');
+            grid.SetWinLength(3);
+            for (int sample = 0; sample < 100; ++sample)
+            {
+                Position position(grid, {'X', 'O'});
+                const size_t plies = random() % grid.GetCellCount();
+                std::vector<Move> moves;
+                while (position.GetPly() < plies && !position.IsLastMoveWin())
+                {
+                    moves.clear();
+                    position.GenerateMoves(moves);
+                    position.MakeMove(moves[random() % moves.size()]);
+                }
+
+                const ProofValue expected = position.IsLastMoveWin() ? ProvenLoss : solver.Solve(position).value;
+                ASSERT_EQ(tablebase.GetValue(position), expected);
+
+                TablebaseEntry entry;
+                if (tablebase.Probe(position, entry))
+                {
+                    // The move keeps the value for the side that made it.
+                    position.MakeMove(entry.bestMove);
+                    const ProofValue after = tablebase.GetValue(position);
+                    EXPECT_EQ(after, expected == ProvenWin ? ProvenLoss : expected == ProvenLoss ? ProvenWin : ProvenDraw);
+                }
+            }
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(TablebaseTest, Probe)
+    {
+        const std::string serialPath = path + ".serial";
+        ASSERT_TRUE(Tablebase::Generate(3, 3, 3, path, 4));
+        ASSERT_TRUE(Tablebase::Generate(3, 3, 3, serialPath, 1));
+
+        Tablebase tablebase;
+        ASSERT_TRUE(tablebase.Open(path));
+        EXPECT_EQ(tablebase.GetPositionCount(), 6046);
+        EXPECT_EQ(tablebase.GetValue(MakePosition({"...", "...", "..."})), ProvenDraw);
+        EXPECT_EQ(tablebase.GetValue(MakePosition({"XOO", "XX.", "..."}, 1)), ProvenLoss);
+
+        TablebaseEntry entry;
+        ASSERT_TRUE(tablebase.Probe(MakePosition({"XX.", "OO.", "..."}), entry));
+        EXPECT_EQ(entry.value, ProvenWin);
+        EXPECT_EQ(entry.bestMove, (Move{0, 2}));
+        // The only draw against a corner opening is the center.
+        ASSERT_TRUE(tablebase.Probe(MakePosition({"X..", "...", "..."}, 1), entry));
+        EXPECT_EQ(entry.value, ProvenDraw);
+        EXPECT_EQ(entry.bestMove, (Move{1, 1}));
+
+        EXPECT_FALSE(tablebase.Probe(MakePosition({"XXX", "OO.", "..."}, 1), entry));
+        EXPECT_EQ(tablebase.GetValue(MakePosition({"X..", "...", "..."})), Unproven);
+        EXPECT_EQ(tablebase.GetValue(MakePosition({"....", "....", "...."})), Unproven);
+
+        // Threads only split the work.
+        auto readFile = [](const std::string &file)
+        {
+            std::ifstream stream(file, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(stream), {});
+        };
+        EXPECT_EQ(readFile(path), readFile(serialPath));
+
+        tablebase.Close();
+        std::filesystem::remove(path);
+        std::filesystem::remove(serialPath);
+        EXPECT_FALSE(tablebase.Open(path));
+    }
+
+    TEST_F(TablebaseTest, TicTacToeTableMatchesTablebase)
+    {
+        ASSERT_TRUE(Tablebase::Generate(3, 3, 3, path));
+        Tablebase tablebase;
+        ASSERT_TRUE(tablebase.Open(path));
+
+        // Every position of the game, from the empty grid on.
+        size_t reachable = 0;
+        Position position = MakePosition({"...", "...", "..."});
+        auto visit = [&](auto &self) -> void
+        {
+            ++reachable;
+            uint16_t index = 0;
+            ASSERT_TRUE(TicTacToe::GetIndex(position, index));
+            ASSERT_EQ(TicTacToe::GetValue(index), tablebase.GetValue(position));
+
+            TablebaseEntry entry;
+            if (!TicTacToe::Probe(position, entry))
+            {
+                EXPECT_TRUE(position.IsLastMoveWin() || position.IsFull());
+                return;
+            }
+            position.MakeMove(entry.bestMove);
+            const ProofValue after = tablebase.GetValue(position);
+            position.UnmakeMove();
+            EXPECT_EQ(after, entry.value == ProvenWin ? ProvenLoss : entry.value == ProvenLoss ? ProvenWin : ProvenDraw);
+
+            std::vector<Move> moves;
+            position.GenerateMoves(moves);
+            for (const Move &move : moves)
+            {
+                position.MakeMove(move);
+                self(self);
+                position.UnmakeMove();
+            }
+        };
+        visit(visit);
+        // Every path, so positions reached by several move orders count once per order.
+        EXPECT_EQ(reachable, 549946);
+
+        tablebase.Close();
+        std::filesystem::remove(path);
+
+        uint16_t index = 0;
+        EXPECT_FALSE(TicTacToe::GetIndex(MakePosition({"X..", "...", "..."}), index));
+        EXPECT_FALSE(TicTacToe::GetIndex(MakePosition({"....", "....", "...."}), index));
+    }
+
+    class ThreatSpaceSearchTest : public ::testing::Test
+    {
+    protected:
+        ThreatSpaceSearch threats{FoursOnly};
+
+        // 15x15 with five in a row to win.
+        static Position MakeGomokuPosition(const std::vector<Move> &crosses, const std::vector<Move> &noughts)
+        {
+            std::vector<std::string> rows(15, std::string(15, '.'));
+            for (const Move &move : crosses)
+                rows[move.row][move.col] = 'X';
+            for (const Move &move : noughts)
+                rows[move.row][move.col] = 'O';
+            return MakePosition(rows, 0, 5);
+        }
+
+        // X fours on column 10, O has to block at (7, 10), and X's next four on row 6 is open at both ends.
+        static Position MakeTwoFoursPosition()
+        {
+            return MakeGomokuPosition({{3, 10}, {4, 10}, {5, 10}, {6, 7}, {6, 8}}, {{2, 10}, {9, 9}, {10, 3}, {12, 12}});
+        }
+    };
+
+    TEST_F(ThreatSpaceSearchTest, FindsDoubleFour)
+    {
+        Position position = MakeGomokuPosition({{7, 5}, {7, 6}, {7, 7}, {4, 8}, {5, 8}, {6, 8}}, {{7, 4}, {3, 8}, {10, 10}, {11, 2}});
+        ThreatResult result = threats.Search(position);
+        ASSERT_TRUE(result.found);
+        EXPECT_EQ(result.sequence, (std::vector<Move>{{7, 8}, {7, 9}, {8, 8}}));
+        EXPECT_EQ(result.stats.depth, 1);
+        EXPECT_EQ(position.GetPly(), 0);
+    }
+
+    TEST_F(ThreatSpaceSearchTest, FindsWinByConsecutiveFours)
+    {
+        Position position = MakeTwoFoursPosition();
+        ThreatResult result = threats.Search(position);
+        ASSERT_TRUE(result.found);
+        ASSERT_EQ(result.sequence.size(), 5);
+        EXPECT_EQ(result.sequence[0], (Move{6, 10}));
+        EXPECT_EQ(result.sequence[1], (Move{7, 10}));
+        EXPECT_EQ(result.sequence[2], (Move{6, 9}));
+        EXPECT_EQ(result.stats.depth, 2);
+        // Only threats are searched, not the 200 odd empty cells.
+        EXPECT_LT(result.stats.nodes, 100);
+    }
+
+    TEST_F(ThreatSpaceSearchTest, ThreesNeedFoursAndThreesMode)
+    {
+        // Two twos crossing at (7, 8): playing there makes two open threes, but no four.
+        Position position = MakeGomokuPosition({{7, 6}, {7, 7}, {5, 8}, {6, 8}}, {{1, 1}, {1, 13}, {13, 1}, {13, 13}});
+        EXPECT_FALSE(threats.Search(position).found);
+
+        threats.SetMode(FoursAndThrees);
+        ThreatResult result = threats.Search(position);
+        ASSERT_TRUE(result.found);
+        EXPECT_EQ(result.sequence.front(), (Move{7, 8}));
+    }
+
+    TEST_F(ThreatSpaceSearchTest, NoThreatsNoWin)
+    {
+        Position position = MakeGomokuPosition({{7, 7}}, {{7, 8}});
+        threats.SetMode(FoursAndThrees);
+        ThreatResult result = threats.Search(position);
+        EXPECT_FALSE(result.found);
+        EXPECT_EQ(result.stats.depth, ThreatSpaceSearch::DEFAULT_MAX_THREATS);
+    }
+
+    TEST_F(ThreatSpaceSearchTest, PrefiltersAlphaBetaSearch)
+    {
+        // The win is five plies deep, out of reach of a depth 2 search without the prefilter.
+        AlphaBetaEngine engine;
+        Position position = MakeTwoFoursPosition();
+        SearchResult result = engine.Search(position, SearchLimits{2});
+        EXPECT_EQ(result.bestMove, (Move{6, 10}));
+        EXPECT_EQ(result.score, WIN_SCORE - 5);
+
+        engine.SetThreatPrefilter(false);
+        result = engine.Search(position, SearchLimits{2});
+        EXPECT_LT(result.score, WIN_THRESHOLD);
+    }
+
+    TEST(PatternTableTest, ClassifiesLines)
+    {
+        std::shared_ptr<const PatternTable> table = PatternTable::Get(5);
+        ASSERT_NE(table, nullptr);
+        EXPECT_EQ(table, PatternTable::Get(5));
+        EXPECT_EQ(table->GetEntryCount(), 243);
+        EXPECT_EQ(PatternTable::Get(PatternTable::MAX_LENGTH + 1), nullptr);
+
+        // One side per cell, 2 for an empty one.
+        auto classify = [&](const std::vector<uint8_t> &sides)
+        { return table->Lookup(PatternTable::Encode(sides)); };
+        EXPECT_EQ(classify({2, 2, 2, 2, 2}).pattern, EmptyPattern);
+        EXPECT_EQ(classify({2, 2, 2, 2, 2}).emptyMask, 0b11111);
+
+        PatternEntry five = classify({0, 0, 0, 0, 0});
+        EXPECT_EQ(five.pattern, FivePattern);
+        EXPECT_EQ(five.score, 1 << 15);
+
+        PatternEntry four = classify({1, 1, 2, 1, 1});
+        EXPECT_EQ(four.pattern, FourPattern);
+        EXPECT_EQ(four.side, 1);
+        EXPECT_EQ(four.emptyMask, 0b00100);
+        EXPECT_EQ(four.score, -(1 << 12));
+
+        EXPECT_EQ(classify({2, 0, 0, 0, 2}).pattern, ThreePattern);
+        EXPECT_EQ(classify({2, 0, 0, 0, 2}).emptyMask, 0b10001);
+        EXPECT_EQ(classify({0, 0, 2, 0, 2}).pattern, BrokenThreePattern);
+        EXPECT_EQ(classify({2, 0, 2, 2, 2}).pattern, FarPattern);
+        EXPECT_EQ(classify({2, 0, 2, 2, 2}).score, 8);
+
+        PatternEntry dead = classify({0, 1, 2, 2, 2});
+        EXPECT_EQ(dead.pattern, DeadPattern);
+        EXPECT_EQ(dead.score, 0);
+    }
+
+    TEST(TranspositionTableTest, StoreAndProbe)
+    {
+        TranspositionTable table(1);
+        EXPECT_EQ(table.GetSizeInBytes(), 1024 * 1024);
+        EXPECT_EQ(table.GetEntryCount(), 1024 * 1024 / 16);
+
+        TranspositionEntry entry;
+        EXPECT_FALSE(table.Probe(0, entry));
+
+        // The empty board hashes to 0, which must not match an empty slot.
+        table.Store(0, {-42, 5, LowerBound, Move{1, 2}});
+        ASSERT_TRUE(table.Probe(0, entry));
+        EXPECT_EQ(entry.score, -42);
+        EXPECT_EQ(entry.depth, 5);
+        EXPECT_EQ(entry.bound, LowerBound);
+        EXPECT_EQ(entry.move, (Move{1, 2}));
+        EXPECT_FALSE(table.Probe(table.GetEntryCount(), entry));
+
+        TranspositionStats stats = table.GetStats();
+        EXPECT_EQ(stats.probes, 3);
+        EXPECT_EQ(stats.hits, 1);
+        EXPECT_EQ(stats.stores, 1);
+        EXPECT_EQ(stats.collisions, 0);
+        EXPECT_GT(table.GetFillRate(), 0.0);
+
+        table.Clear();
+        EXPECT_FALSE(table.Probe(0, entry));
+        EXPECT_EQ(table.GetFillRate(), 0.0);
+    }
+
+    TEST(TranspositionTableTest, DepthPreferredReplacement)
+    {
+        TranspositionTable table(0);
+        ASSERT_EQ(table.GetEntryCount(), 4);
+
+        // A shallower bound does not replace a deeper result from the same search.
+        TranspositionEntry entry;
+        table.Store(7, {10, 6, ExactBound, Move{0, 0}});
+        table.Store(7, {20, 2, LowerBound, Move{1, 1}});
+        ASSERT_TRUE(table.Probe(7, entry));
+        EXPECT_EQ(entry.score, 10);
+
+        // With the single bucket full, a new position evicts the shallowest entry.
+        table.Store(1, {1, 8, ExactBound, Move{0, 0}});
+        table.Store(2, {2, 1, ExactBound, Move{0, 0}});
+        table.Store(3, {3, 9, ExactBound, Move{0, 0}});
+        table.Store(4, {4, 4, ExactBound, Move{0, 0}});
+        EXPECT_FALSE(table.Probe(2, entry));
+        EXPECT_TRUE(table.Probe(7, entry));
+        EXPECT_EQ(table.GetStats().collisions, 1);
+
+        // Entries from older searches go before deeper ones from the current search.
+        table.NewSearch();
+        table.Store(5, {5, 1, ExactBound, Move{0, 0}});
+        EXPECT_TRUE(table.Probe(5, entry));
+        EXPECT_EQ(table.GetFillRate(), 0.25);
+    }
+
+    TEST(TranspositionTableTest, ConcurrentStoresNeverReadTorn)
+    {
+        // Few buckets so threads keep overwriting each other's slots; every entry is derived from its key.
+        TranspositionTable table(0);
+        auto worker = [&table](uint64_t seed)
+        {
+            std::mt19937_64 random(seed);
+            size_t bad = 0;
+            for (int i = 0; i < 100000; ++i)
+            {
+                uint64_t hash = random() % 64;
+                TranspositionEntry entry;
+                if (table.Probe(hash, entry))
+                    bad += entry.score != static_cast<int>(hash) || entry.depth != hash % 32;
+                table.Store(hash, {static_cast<int>(hash), static_cast<unsigned char>(hash % 32), ExactBound, Move{0, 0}});
+            }
+            return bad;
+        };
+
+        std::vector<std::thread> threads;
+        std::vector<size_t> bad(4, 0);
+        for (size_t i = 0; i < bad.size(); ++i)
+            threads.emplace_back([&, i]
+                                 { bad[i] = worker(i + 1); });
+        for (std::thread &thread : threads)
+            thread.join();
+        for (size_t count : bad)
+            EXPECT_EQ(count, 0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    DURLIB::Log::Init();
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <gridworks.h>
 #include <durlib.h>
 
+#include <filesystem>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace GridWorks
@@ -64,6 +67,170 @@ namespace GridWorks
         EXPECT_EQ(gameLogic->GetWinner(), players[0]);
     }
 
+    TEST_F(GameLogicTest, DrawCondition)
+    {
+        gameLogic->MakeMove(0, 0);
+        gameLogic->MakeMove(0, 1);
+        gameLogic->MakeMove(0, 2);
+        gameLogic->MakeMove(1, 1);
+        gameLogic->MakeMove(1, 0);
+        gameLogic->MakeMove(1, 2);
+        gameLogic->MakeMove(2, 1);
+        gameLogic->MakeMove(2, 0);
+        EXPECT_EQ(gameLogic->GetGameState(), GameState::InProgress);
+        gameLogic->MakeMove(2, 2);
+
+        EXPECT_EQ(gameLogic->GetGameState(), GameState::GameOver);
+        EXPECT_EQ(gameLogic->GetGameOverType(), GameOverType::Draw);
+        EXPECT_EQ(gameLogic->GetWinner(), nullptr);
+    }
+
+    TEST_F(GameLogicTest, ValidateWinCheckAgreesOnAWin)
+    {
+        // Validate asserts that the compile-time 3x3 lines, the line walk and the full scan agree on every move.
+        TurnManager *turnManager = gameLogic->GetGameConfiguration()->turnManager;
+        turnManager->SetWinCheckMode(WinCheckMode::Validate);
+        gameLogic->MakeMove(0, 0);
+        gameLogic->MakeMove(1, 0);
+        gameLogic->MakeMove(1, 1);
+        gameLogic->MakeMove(0, 1);
+        gameLogic->MakeMove(2, 2);
+        EXPECT_EQ(gameLogic->GetGameOverType(), GameOverType::Win);
+        EXPECT_EQ(gameLogic->GetWinner(), players[0]);
+    }
+
+    TEST_F(GameLogicTest, PositionHashIncludesSideToMove)
+    {
+        TurnManager *turnManager = gameLogic->GetGameConfiguration()->turnManager;
+        EXPECT_EQ(turnManager->GetPositionHash(grid), grid->GetHash());
+
+        gameLogic->MakeMove(1, 1);
+        EXPECT_EQ(turnManager->GetPositionHash(grid), grid->GetHash() ^ Zobrist::GetSideKey(1));
+        EXPECT_NE(turnManager->GetPositionHash(grid), grid->GetHash());
+    }
+
+    TEST_F(GameLogicTest, CanonicalPositionHashIgnoresSymmetry)
+    {
+        TurnManager *turnManager = gameLogic->GetGameConfiguration()->turnManager;
+        Grid mirrored(grid->GetRows(), grid->GetCols(), grid->GetDefaultChar());
+        mirrored.SetCharAt(0, grid->GetCols() - 1, 'X');
+
+        gameLogic->MakeMove(0, 0);
+        CanonicalForm canonical = turnManager->GetCanonicalPositionHash(grid);
+        EXPECT_EQ(canonical.hash, turnManager->GetCanonicalPositionHash(&mirrored).hash);
+        EXPECT_EQ(canonical.hash, grid->GetSymmetryHash(canonical.symmetry) ^ Zobrist::GetSideKey(1));
+    }
+
+    TEST_F(GameLogicTest, AIPlayerMoves)
+    {
+        // Player1 is a human playing X, Player2 is the AI; the engine searches instead of the built-in 3x3 table.
+        gameLogic->SetUseTicTacToeTable(false);
+        EXPECT_FALSE(gameLogic->IsAITurn());
+        gameLogic->MakeMove(0, 0);
+        ASSERT_TRUE(gameLogic->IsAITurn());
+
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(grid->GetCharAt(result.bestMove.row, result.bestMove.col), 'O');
+        EXPECT_EQ(grid->GetOccupiedCount(), 2);
+        EXPECT_GT(result.stats.nodes, 0);
+        EXPECT_FALSE(gameLogic->IsAITurn());
+    }
+
+    TEST_F(GameLogicTest, CancelSentBeforeTheAIMoveStopsIt)
+    {
+        gameLogic->SetUseTicTacToeTable(false);
+        gameLogic->MakeMove(0, 0);
+        GameLogic::CancelAIMove();
+        SearchResult cancelled = gameLogic->MakeAIMove();
+        EXPECT_EQ(grid->GetOccupiedCount(), 2);
+        EXPECT_LE(cancelled.stats.nodes, 1);
+
+        // The cancel ended with its turn, so the next AI move searches in full.
+        gameLogic->MakeMove(2, cancelled.bestMove == Move{2, 2} ? 1 : 2);
+        SearchResult searched = gameLogic->MakeAIMove();
+        EXPECT_EQ(grid->GetOccupiedCount(), 4);
+        EXPECT_GT(searched.stats.nodes, 1);
+    }
+
+    TEST_F(GameLogicTest, AIPlayerMovesWithMCTS)
+    {
+        gameLogic->SetEngine(std::make_unique<MCTSEngine>());
+        gameLogic->SetUseTicTacToeTable(false);
+        gameLogic->MakeMove(0, 0);
+
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(grid->GetCharAt(result.bestMove.row, result.bestMove.col), 'O');
+        EXPECT_GT(result.stats.playouts, 0);
+    }
+
+    TEST_F(GameLogicTest, AIPlayerMovesFromOpeningBook)
+    {
+        gameLogic->MakeMove(0, 0);
+        OpeningBookBuilder builder;
+        builder.Add(Position(grid, gameLogic->GetGameConfiguration()->turnManager), Move{2, 1}, 0);
+        const std::string path = (std::filesystem::temp_directory_path() / "gridworks_game_book.bin").string();
+        ASSERT_TRUE(builder.Write(path));
+        std::shared_ptr<OpeningBook> book = std::make_shared<OpeningBook>();
+        ASSERT_TRUE(book->Open(path));
+        gameLogic->SetOpeningBook(book);
+
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(result.bestMove, (Move{2, 1}));
+        EXPECT_EQ(result.stats.nodes, 0);
+        EXPECT_EQ(grid->GetCharAt(2, 1), 'O');
+
+        gameLogic->SetOpeningBook(nullptr);
+        book.reset();
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(GameLogicTest, AIPlayerMovesFromTablebase)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "gridworks_game_tablebase.bin").string();
+        ASSERT_TRUE(Tablebase::Generate(grid->GetRows(), grid->GetCols(), grid->GetWinLength(), path));
+        std::shared_ptr<Tablebase> tablebase = std::make_shared<Tablebase>();
+        ASSERT_TRUE(tablebase->Open(path));
+        gameLogic->SetTablebase(tablebase);
+
+        // The only draw against a corner opening is the center.
+        gameLogic->MakeMove(0, 0);
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(result.bestMove, (Move{1, 1}));
+        EXPECT_EQ(result.score, 0);
+        EXPECT_EQ(result.stats.nodes, 0);
+
+        gameLogic->SetTablebase(nullptr);
+        tablebase.reset();
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(GameLogicTest, AIPlayerMovesFromTicTacToeTable)
+    {
+        // The only draw against a corner opening is the center.
+        gameLogic->MakeMove(0, 0);
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(result.bestMove, (Move{1, 1}));
+        EXPECT_EQ(result.score, 0);
+        EXPECT_EQ(result.stats.nodes, 0);
+
+        // Against opposite corners a corner loses and every edge draws.
+        gameLogic->MakeMove(2, 2);
+        result = gameLogic->MakeAIMove();
+        EXPECT_EQ((result.bestMove.row + result.bestMove.col) % 2, 1);
+        EXPECT_EQ(result.score, 0);
+    }
+
+    TEST_F(GameLogicTest, PlayerSearchLimitsOverrideConfiguration)
+    {
+        players[1]->SetSearchLimits(SearchLimits{1, 0, 0.0});
+        gameLogic->SetUseTicTacToeTable(false);
+        gameLogic->MakeMove(0, 0);
+
+        SearchResult result = gameLogic->MakeAIMove();
+        EXPECT_EQ(result.stats.depth, 1);
+        EXPECT_EQ(grid->GetOccupiedCount(), 2);
+    }
+
     TEST_F(GameLogicTest, OverwriteMoveAttempt)
     {
         gameLogic->MakeMove(0, 0);                   // Player X makes a move
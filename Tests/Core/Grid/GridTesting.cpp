@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 #include "Grid/Grid.h"
+#include "Grid/FixedGrid.h"
+#include "Grid/GridPool.h"
+#include "Grid/RunKernels.h"
+#include "Grid/WinLineTable.h"
+#include "Grid/Zobrist.h"
+
+#include <random>
 
 int main(int argc, char **argv)
 {
@@ -69,7 +76,7 @@ namespace GridWorks
     // Test index operator for valid index.
     TEST_F(GridTest, IndexOperatorValid)
     {
-        grid->GetGrid()[0][0] = 'X';
+        grid->SetCharAt(0, 0, 'X');
         EXPECT_EQ((*grid)[0][0], 'X');
     }
 
@@ -90,6 +97,22 @@ namespace GridWorks
         EXPECT_EQ(grid->GetCols(), 5);
     }
 
+    // Test that the setters refuse a shape the buffer can not hold.
+    TEST_F(GridTest, SettersStayInsideTheBuffer)
+    {
+        const unsigned char rows = grid->GetRows();
+        const unsigned char cols = grid->GetCols();
+        EXPECT_THROW(grid->SetRows(rows + 1), std::out_of_range);
+        EXPECT_THROW(grid->SetCols(cols + 1), std::out_of_range);
+        EXPECT_EQ(grid->GetRows(), rows);
+        EXPECT_EQ(grid->GetCols(), cols);
+
+        // Growing back within the buffer is fine.
+        grid->SetRows(rows - 1);
+        grid->SetRows(rows);
+        EXPECT_EQ(grid->GetRows(), rows);
+    }
+
     // Test getters.
     TEST_F(GridTest, Operator)
     {
@@ -105,13 +128,64 @@ namespace GridWorks
     // Test getters.
     TEST_F(GridTest, GetGrid)
     {
-        char **gridArray = grid->GetGrid();
+        GridView gridArray = grid->GetGrid();
 
         EXPECT_EQ(gridArray[0][0], '*');
         EXPECT_EQ(gridArray[1][1], '*');
         EXPECT_EQ(gridArray[2][2], '*');
     }
 
+    // Test that rows are laid out back to back in a single buffer.
+    TEST_F(GridTest, ContiguousStorage)
+    {
+        GridView view = grid->GetGrid();
+
+        EXPECT_EQ(view.stride, grid->GetCols());
+        for (unsigned char row = 1; row < view.rows; ++row)
+        {
+            EXPECT_EQ(view[row], view[row - 1] + view.stride);
+        }
+
+        grid->SetCharAt(3, 4, 'X');
+        EXPECT_EQ(view.data[3 * view.stride + 4], 'X');
+        EXPECT_EQ(view.Row(3)[4], 'X');
+        EXPECT_EQ(view.Row(3).size(), grid->GetCols());
+    }
+
+    // Test copying a whole view into another grid.
+    TEST_F(GridTest, SetGrid)
+    {
+        Grid source(10, 10, '*');
+        source.SetCharAt(0, 0, 'X');
+        source.SetCharAt(9, 9, 'O');
+
+        grid->SetGrid(source.GetGrid());
+        EXPECT_EQ(grid->GetCharAt(0, 0), 'X');
+        EXPECT_EQ(grid->GetCharAt(9, 9), 'O');
+        EXPECT_EQ(grid->GetCharAt(5, 5), '*');
+
+        Grid wrongSize(3, 3, '*');
+        EXPECT_THROW(grid->SetGrid(wrongSize.GetGrid()), std::invalid_argument);
+    }
+
+    // Test resizing keeps the storage contiguous and reset.
+    TEST_F(GridTest, ResetGridWithNewSize)
+    {
+        grid->SetCharAt(1, 1, 'X');
+        grid->ResetGridWithNewSize(4, 6, '.');
+
+        EXPECT_EQ(grid->GetRows(), 4);
+        EXPECT_EQ(grid->GetCols(), 6);
+        EXPECT_EQ(grid->GetGrid().stride, 6);
+        for (unsigned char row = 0; row < grid->GetRows(); ++row)
+        {
+            for (unsigned char col = 0; col < grid->GetCols(); ++col)
+            {
+                EXPECT_EQ(grid->GetCharAt(row, col), '.');
+            }
+        }
+    }
+
     // Test getters.
     TEST_F(GridTest, GetRows)
     {
@@ -156,4 +230,483 @@ namespace GridWorks
         EXPECT_EQ(fmt::format("{}", *actual), expectedOutput);
     }
 
+    // Test that the occupied cell counter follows every change to the grid.
+    TEST_F(GridTest, OccupiedCount)
+    {
+        EXPECT_EQ(grid->GetCellCount(), 100);
+        EXPECT_EQ(grid->GetOccupiedCount(), 0);
+
+        grid->SetCharAt(0, 0, 'X');
+        grid->SetCharAt(0, 1, 'O');
+        EXPECT_EQ(grid->GetOccupiedCount(), 2);
+
+        // Overwriting an occupied cell does not change the count, clearing it does.
+        grid->SetCharAt(0, 1, 'X');
+        EXPECT_EQ(grid->GetOccupiedCount(), 2);
+        grid->SetCharAt(0, 1, grid->GetDefaultChar());
+        EXPECT_EQ(grid->GetOccupiedCount(), 1);
+
+        grid->ResetGrid();
+        EXPECT_EQ(grid->GetOccupiedCount(), 0);
+
+        grid->ResetGridWithNewSize(2, 2, '.');
+        EXPECT_FALSE(grid->IsFull());
+        grid->SetCharAt(0, 0, 'X');
+        grid->SetCharAt(0, 1, 'O');
+        grid->SetCharAt(1, 0, 'X');
+        grid->SetCharAt(1, 1, 'O');
+        EXPECT_TRUE(grid->IsFull());
+
+        grid->ResetGridWithNewChar('-');
+        EXPECT_EQ(grid->GetOccupiedCount(), 0);
+    }
+
+    // Test gomoku style win lengths.
+    TEST_F(GridTest, WinLength)
+    {
+        Grid board(15, 15, '.');
+        board.SetWinLength(5);
+        EXPECT_EQ(board.GetWinLength(), 5);
+
+        for (unsigned char i = 0; i < 4; ++i)
+        {
+            board.SetCharAt(7, 3 + i, 'X');
+            board.SetCharAt(3 + i, 7, 'O');
+            board.SetCharAt(i, i, 'X');
+            board.SetCharAt(i, 14 - i, 'O');
+        }
+        EXPECT_FALSE(board.CheckForRecurringCharsInRow('X'));
+        EXPECT_FALSE(board.CheckForRecurringCharsInCol('O'));
+        EXPECT_FALSE(board.CheckForRecurringCharsInDiagonal('X'));
+        EXPECT_FALSE(board.CheckForRecurringCharsInAntiDiagonal('O'));
+        EXPECT_FALSE(board.GetBitBoard().HasRun('X', 5));
+
+        board.SetCharAt(7, 7, 'X');
+        EXPECT_TRUE(board.CheckForRecurringCharsInRow('X'));
+        EXPECT_TRUE(board.CheckForRecurringCharsAround(7, 7));
+        board.SetCharAt(4, 4, 'X');
+        EXPECT_TRUE(board.CheckForRecurringCharsInDiagonal('X'));
+        board.SetCharAt(4, 10, 'O');
+        EXPECT_TRUE(board.CheckForRecurringCharsInAntiDiagonal('O'));
+        board.SetCharAt(7, 7, 'O');
+        EXPECT_TRUE(board.CheckForRecurringCharsInCol('O'));
+        EXPECT_TRUE(board.GetBitBoard().HasRun('O', 5));
+
+        EXPECT_THROW(board.SetWinLength(0), std::invalid_argument);
+    }
+
+    // Test that the vectorized run kernels agree with the scalar ones, including runs across block boundaries.
+    TEST_F(GridTest, RunKernelsMatchScalar)
+    {
+        std::mt19937 rng(42);
+        for (unsigned char size : {7, 16, 31, 33, 64, 100, 255})
+        {
+            Grid board(size, size, '.');
+            for (unsigned char runLength : {3, 5, 6, 40})
+            {
+                for (int round = 0; round < 20; ++round)
+                {
+                    // Dense boards produce long runs, so the carries between blocks get exercised.
+                    for (unsigned char row = 0; row < size; ++row)
+                        for (unsigned char col = 0; col < size; ++col)
+                            board.SetCharAt(row, col, rng() % 8 == 0 ? 'O' : 'X');
+
+                    GridView view = board.GetGrid();
+                    for (unsigned char row = 0; row < size; ++row)
+                    {
+                        EXPECT_EQ(RunKernels::HasRowRun(view[row], view.cols, 'X', runLength),
+                                  RunKernels::HasRowRunScalar(view[row], view.cols, 'X', runLength));
+                    }
+                    EXPECT_EQ(RunKernels::HasColumnRun(view.data, view.rows, view.cols, view.stride, 'X', runLength),
+                              RunKernels::HasColumnRunScalar(view.data, view.rows, view.cols, view.stride, 'X', runLength));
+                }
+            }
+        }
+    }
+
+    // Test that the incremental hash only depends on the position, not on how it was reached.
+    TEST_F(GridTest, ZobristHash)
+    {
+        EXPECT_EQ(grid->GetHash(), 0);
+
+        grid->SetCharAt(1, 2, 'X');
+        grid->SetCharAt(3, 4, 'O');
+        uint64_t hash = grid->GetHash();
+        EXPECT_EQ(hash, Zobrist::GetCellKey(1, 2, 'X') ^ Zobrist::GetCellKey(3, 4, 'O'));
+
+        Grid other(10, 10, '*');
+        other.SetCharAt(3, 4, 'X');
+        other.SetCharAt(3, 4, 'O');
+        other.SetCharAt(1, 2, 'X');
+        EXPECT_EQ(other.GetHash(), hash);
+
+        // Chars that are not a MoveType do not change the hash.
+        other.SetCharAt(5, 5, '#');
+        EXPECT_EQ(other.GetHash(), hash);
+
+        grid->SetCharAt(1, 2, grid->GetDefaultChar());
+        EXPECT_EQ(grid->GetHash(), Zobrist::GetCellKey(3, 4, 'O'));
+
+        grid->ResetGrid();
+        EXPECT_EQ(grid->GetHash(), 0);
+
+        grid->SetGrid(other.GetGrid());
+        EXPECT_EQ(grid->GetHash(), hash);
+    }
+
+    // Test that the key tables are the same on every run and machine.
+    TEST_F(GridTest, ZobristKeysAreStable)
+    {
+        EXPECT_EQ(Zobrist::GetCellKey(0, 0, 'X'), 0x6E789E6AA1B965F4ULL);
+        EXPECT_EQ(Zobrist::GetCellKey(254, 254, 'O'), 0x50FABD4CA27CE322ULL);
+        EXPECT_NE(Zobrist::GetCellKey(0, 0, 'X'), Zobrist::GetCellKey(0, 0, 'O'));
+        EXPECT_EQ(Zobrist::GetCellKey(0, 0, '.'), 0);
+        EXPECT_EQ(Zobrist::GetSideKey(0), 0);
+        EXPECT_NE(Zobrist::GetSideKey(1), 0);
+    }
+
+    // Test that every symmetry hash equals the plain hash of the grid transformed by that symmetry.
+    TEST_F(GridTest, SymmetryHashesMatchTransformedGrid)
+    {
+        for (auto [rows, cols] : {std::pair<unsigned char, unsigned char>{5, 5}, {3, 5}})
+        {
+            Grid original(rows, cols, '.');
+            original.SetCharAt(0, 1, 'X');
+            original.SetCharAt(1, 3, 'O');
+            original.SetCharAt(2, 0, 'X');
+            original.SetCharAt(2, 4, 'X');
+            original.SetCharAt(2, 4, 'O');
+
+            CanonicalForm canonical = original.GetCanonicalForm();
+            for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+            {
+                Symmetry symmetry = static_cast<Symmetry>(i);
+                if (!IsSymmetryValid(symmetry, rows, cols))
+                {
+                    EXPECT_EQ(original.GetSymmetryHash(symmetry), 0);
+                    continue;
+                }
+
+                Grid transformed(rows, cols, '.');
+                for (unsigned char row = 0; row < rows; ++row)
+                {
+                    for (unsigned char col = 0; col < cols; ++col)
+                    {
+                        auto [symmetryRow, symmetryCol] = ApplySymmetry(symmetry, row, col, rows, cols);
+                        transformed.SetCharAt(symmetryRow, symmetryCol, original.GetCharAt(row, col));
+
+                        auto [inverseRow, inverseCol] = ApplySymmetry(InverseSymmetry(symmetry), symmetryRow, symmetryCol, rows, cols);
+                        EXPECT_EQ(inverseRow, row);
+                        EXPECT_EQ(inverseCol, col);
+                    }
+                }
+                EXPECT_EQ(original.GetSymmetryHash(symmetry), transformed.GetHash());
+                EXPECT_LE(canonical.hash, transformed.GetHash());
+
+                // Every transformed grid canonicalizes to the same hash.
+                EXPECT_EQ(transformed.GetCanonicalForm().hash, canonical.hash);
+            }
+            EXPECT_EQ(original.GetSymmetryHash(canonical.symmetry), canonical.hash);
+        }
+    }
+
+    // Test that the symmetry hashes survive resets and SetGrid.
+    TEST_F(GridTest, CanonicalFormAfterReset)
+    {
+        Grid square(3, 3, '.');
+        square.SetCharAt(0, 0, 'X');
+        Grid corner(3, 3, '.');
+        corner.SetCharAt(2, 2, 'X');
+        EXPECT_NE(square.GetHash(), corner.GetHash());
+        EXPECT_EQ(square.GetCanonicalForm().hash, corner.GetCanonicalForm().hash);
+
+        square.ResetGrid();
+        for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+            EXPECT_EQ(square.GetSymmetryHash(static_cast<Symmetry>(i)), 0);
+
+        square.SetGrid(corner.GetGrid());
+        for (unsigned char i = 0; i < SYMMETRY_COUNT; ++i)
+            EXPECT_EQ(square.GetSymmetryHash(static_cast<Symmetry>(i)), corner.GetSymmetryHash(static_cast<Symmetry>(i)));
+    }
+
+    // Test that copies are deep and carry the derived state along.
+    TEST_F(GridTest, CopyAndMove)
+    {
+        grid->SetWinLength(4);
+        grid->SetCharAt(1, 2, 'X');
+        grid->SetCharAt(3, 4, 'O');
+
+        Grid copy(*grid);
+        EXPECT_EQ(copy.GetCharAt(1, 2), 'X');
+        EXPECT_EQ(copy.GetHash(), grid->GetHash());
+        EXPECT_EQ(copy.GetOccupiedCount(), 2);
+        EXPECT_EQ(copy.GetWinLength(), 4);
+        EXPECT_EQ(copy.GetLastChangedChar(), grid->GetLastChangedChar());
+        EXPECT_TRUE(copy.GetBitBoard().Test(3, 4, 'O'));
+
+        copy.SetCharAt(0, 0, 'X');
+        EXPECT_EQ(grid->GetCharAt(0, 0), grid->GetDefaultChar());
+        EXPECT_NE(copy.GetHash(), grid->GetHash());
+
+        // Assigning a smaller grid reuses the buffer, assigning a bigger one grows it.
+        Grid small(2, 3, '.');
+        small.SetCharAt(1, 1, 'O');
+        copy = small;
+        EXPECT_EQ(copy.GetRows(), 2);
+        EXPECT_EQ(copy.GetCols(), 3);
+        EXPECT_EQ(copy.GetGrid().stride, 3);
+        EXPECT_EQ(copy.GetCharAt(1, 1), 'O');
+        EXPECT_EQ(copy.GetHash(), small.GetHash());
+        small = *grid;
+        EXPECT_EQ(small.GetRows(), 10);
+        EXPECT_EQ(small.GetCharAt(3, 4), 'O');
+
+        // A grid shrunk in place keeps its old stride; copies are packed.
+        grid->ResetGridWithNewSize(3, 3, '.');
+        grid->SetCharAt(2, 2, 'X');
+        Grid packed(*grid);
+        EXPECT_EQ(packed.GetGrid().stride, 3);
+        EXPECT_EQ(packed.GetCharAt(2, 2), 'X');
+
+        uint64_t copyHash = copy.GetHash();
+        Grid moved(std::move(copy));
+        EXPECT_EQ(moved.GetCharAt(1, 1), 'O');
+        EXPECT_EQ(copy.GetRows(), 0);
+        EXPECT_EQ(copy.GetCellCount(), 0);
+        copy = std::move(moved);
+        EXPECT_EQ(copy.GetCharAt(1, 1), 'O');
+        EXPECT_EQ(copy.GetHash(), copyHash);
+        EXPECT_TRUE(copy.GetBitBoard().Test(1, 1, 'O'));
+    }
+
+    // Test that pooled snapshots copy the source and go back to the pool.
+    TEST_F(GridTest, GridPoolSnapshots)
+    {
+        GridPool pool(10, 10, 2);
+        EXPECT_EQ(pool.GetFreeCount(), 2);
+
+        grid->SetCharAt(5, 5, 'X');
+        {
+            GridSnapshot first = pool.Acquire(*grid);
+            GridSnapshot second = pool.Acquire(*grid);
+            EXPECT_EQ(pool.GetFreeCount(), 0);
+            EXPECT_EQ(first->GetCharAt(5, 5), 'X');
+            EXPECT_EQ(second->GetHash(), grid->GetHash());
+
+            // Snapshots are independent of each other and of the source.
+            first->SetCharAt(0, 0, 'O');
+            EXPECT_EQ(second->GetCharAt(0, 0), grid->GetDefaultChar());
+            EXPECT_EQ(grid->GetCharAt(0, 0), grid->GetDefaultChar());
+
+            // An exhausted pool grows instead of failing.
+            GridSnapshot third = pool.Acquire(*second);
+            EXPECT_EQ(pool.GetSize(), 4);
+            EXPECT_EQ(third->GetHash(), grid->GetHash());
+
+            second.Release();
+            EXPECT_FALSE(second);
+            EXPECT_EQ(pool.GetFreeCount(), 2);
+        }
+        EXPECT_EQ(pool.GetFreeCount(), 4);
+    }
+
+    static_assert(FixedGrid3x3::LINE_COUNT == 8);
+    static_assert(FixedGrid4x4::LINE_COUNT == 24);
+    static_assert(FixedGrid3x3::IsFull(FixedGrid3x3::FULL_MASK));
+
+    // Compares the compile-time checks with the runtime Grid on random positions of the same shape.
+    template <typename Fixed>
+    static void ExpectFixedGridMatchesGrid(std::mt19937 &rng)
+    {
+        const char chars[] = {'.', 'X', 'O'};
+        for (int iteration = 0; iteration < 500; ++iteration)
+        {
+            Grid grid(Fixed::ROWS, Fixed::COLS, '.');
+            grid.SetWinLength(Fixed::WIN_LENGTH);
+            Fixed fixed;
+            for (unsigned char row = 0; row < Fixed::ROWS; ++row)
+            {
+                for (unsigned char col = 0; col < Fixed::COLS; ++col)
+                {
+                    char cell = chars[rng() % 3];
+                    grid.SetCharAt(row, col, cell);
+                    fixed.SetCharAt(row, col, cell);
+                }
+            }
+
+            EXPECT_EQ(fixed.IsFull(), grid.IsFull());
+            for (char playerChar : {'X', 'O'})
+            {
+                EXPECT_EQ(fixed.IsWin(playerChar), grid.GetBitBoard().HasRun(playerChar, Fixed::WIN_LENGTH));
+                EXPECT_EQ(Fixed::HasRun(*grid.GetBitBoard().GetWords(playerChar)), fixed.IsWin(playerChar));
+            }
+            for (unsigned char row = 0; row < Fixed::ROWS; ++row)
+            {
+                for (unsigned char col = 0; col < Fixed::COLS; ++col)
+                {
+                    if (grid.GetCharAt(row, col) != '.')
+                    {
+                        EXPECT_EQ(fixed.IsWinAt(row, col), grid.CheckForRecurringCharsAround(row, col));
+                    }
+                }
+            }
+
+            Fixed copy(grid);
+            EXPECT_EQ(copy.GetBits('X'), fixed.GetBits('X'));
+            EXPECT_EQ(copy.GetBits('O'), fixed.GetBits('O'));
+        }
+    }
+
+    TEST_F(GridTest, FixedGridMatchesGrid)
+    {
+        std::mt19937 rng(11);
+        ExpectFixedGridMatchesGrid<FixedGrid3x3>(rng);
+        ExpectFixedGridMatchesGrid<FixedGrid4x4>(rng);
+        ExpectFixedGridMatchesGrid<FixedGrid<5, 4, 4>>(rng);
+        ExpectFixedGridMatchesGrid<FixedGrid<8, 8, 5>>(rng);
+
+        EXPECT_ANY_THROW(FixedGrid3x3{*grid});
+    }
+
+    // Test the line layout of the classic board.
+    TEST_F(GridTest, WinLineTableLayout)
+    {
+        WinLineTable table(3, 3, 3);
+        EXPECT_EQ(table.GetLineCount(), 8);
+        EXPECT_EQ(table.GetDirectionRange(LineDirection::Horizontal), (std::pair<size_t, size_t>{0, 3}));
+        EXPECT_EQ(table.GetDirectionRange(LineDirection::AntiDiagonal), (std::pair<size_t, size_t>{7, 8}));
+
+        std::span<const uint16_t> antiDiagonal = table.GetLineCells(7);
+        EXPECT_EQ(std::vector<uint16_t>(antiDiagonal.begin(), antiDiagonal.end()), (std::vector<uint16_t>{2, 4, 6}));
+
+        EXPECT_EQ(table.GetLinesThrough(1, 1).size(), 4);
+        EXPECT_EQ(table.GetLinesThrough(0, 0).size(), 3);
+        EXPECT_EQ(table.GetLinesThrough(0, 1).size(), 2);
+        EXPECT_EQ(table.FromCell(table.ToCell(2, 1)), (std::pair<unsigned char, unsigned char>{2, 1}));
+
+        // A win length longer than the grid leaves no lines at all.
+        EXPECT_EQ(WinLineTable(3, 3, 4).GetLineCount(), 0);
+    }
+
+    // Test that every line through a cell contains it, and that tables are shared per shape.
+    TEST_F(GridTest, WinLineTableCellLists)
+    {
+        std::shared_ptr<const WinLineTable> table = WinLineTable::Get(7, 5, 4);
+        EXPECT_EQ(table, WinLineTable::Get(7, 5, 4));
+        EXPECT_NE(table, WinLineTable::Get(7, 5, 3));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(table->GetLineCells(0).data()) % 64, 0);
+
+        size_t memberships = 0;
+        for (unsigned char row = 0; row < 7; ++row)
+        {
+            for (unsigned char col = 0; col < 5; ++col)
+            {
+                std::span<const uint32_t> lines = table->GetLinesThrough(row, col);
+                std::span<const uint8_t> positions = table->GetLinePositionsThrough(row, col);
+                ASSERT_EQ(positions.size(), lines.size());
+                for (size_t i = 0; i < lines.size(); ++i)
+                {
+                    std::span<const uint16_t> cells = table->GetLineCells(lines[i]);
+                    EXPECT_EQ(cells[positions[i]], table->ToCell(row, col));
+                    ++memberships;
+                }
+            }
+        }
+        EXPECT_EQ(memberships, table->GetLineCount() * 4);
+    }
+
+    // Test that the winning line through the last move is found.
+    TEST_F(GridTest, WinningLine)
+    {
+        grid->SetWinLength(4);
+        for (unsigned char i = 0; i < 4; ++i)
+            grid->SetCharAt(2 + i, 6 - i, 'O');
+
+        EXPECT_TRUE(grid->GetWinningLine(0, 0).empty());
+        EXPECT_TRUE(grid->GetWinningLine(9, 9).empty());
+
+        std::span<const uint16_t> line = grid->GetWinningLine(3, 5);
+        ASSERT_EQ(line.size(), 4);
+        for (uint16_t cell : line)
+        {
+            auto [row, col] = grid->GetWinLines().FromCell(cell);
+            EXPECT_EQ(grid->GetCharAt(row, col), 'O');
+        }
+
+        // Shrinking the grid in place keeps a wider stride; lookups still land on the right cells.
+        grid->ResetGridWithNewSize(4, 4, '.');
+        grid->SetWinLength(3);
+        for (unsigned char i = 0; i < 3; ++i)
+            grid->SetCharAt(i, 3, 'X');
+        EXPECT_EQ(grid->GetWinningLine(1, 3).size(), 3);
+    }
+
+    // Test that the bitsets follow every SetCharAt and reset.
+    TEST_F(GridTest, BitBoardTracksMoves)
+    {
+        const BitBoard &bitBoard = grid->GetBitBoard();
+        EXPECT_FALSE(bitBoard.IsSingleWord());
+
+        grid->SetCharAt(2, 3, 'X');
+        EXPECT_TRUE(bitBoard.Test(2, 3, 'X'));
+        EXPECT_FALSE(bitBoard.Test(2, 3, 'O'));
+
+        grid->SetCharAt(2, 3, 'O');
+        EXPECT_FALSE(bitBoard.Test(2, 3, 'X'));
+        EXPECT_TRUE(bitBoard.Test(2, 3, 'O'));
+
+        grid->ResetGrid();
+        EXPECT_FALSE(bitBoard.Test(2, 3, 'O'));
+
+        grid->ResetGridWithNewSize(8, 8, '.');
+        EXPECT_TRUE(grid->GetBitBoard().IsSingleWord());
+    }
+
+    // Test that runs do not wrap from the end of one row into the next.
+    TEST_F(GridTest, BitBoardRunsDoNotWrap)
+    {
+        for (unsigned char size : {8, 10})
+        {
+            Grid board(size, size, '.');
+            board.SetCharAt(0, size - 2, 'X');
+            board.SetCharAt(0, size - 1, 'X');
+            board.SetCharAt(1, 0, 'X');
+            EXPECT_FALSE(board.GetBitBoard().HasRun('X', 3));
+
+            board.SetCharAt(1, 1, 'O');
+            board.SetCharAt(2, 0, 'O');
+            board.SetCharAt(0, size - 1, 'O');
+            EXPECT_FALSE(board.GetBitBoard().HasRun('O', 3));
+        }
+    }
+
+    // Test that both win detection backends agree on random boards of every layout.
+    TEST_F(GridTest, BitBoardMatchesScans)
+    {
+        std::mt19937 rng(1234);
+        for (unsigned char size : {3, 5, 8, 9, 16, 31})
+        {
+            for (int game = 0; game < 50; ++game)
+            {
+                Grid board(size, static_cast<unsigned char>(size + game % 3), '.');
+                std::uniform_int_distribution<int> cell(0, 2);
+                for (unsigned char row = 0; row < board.GetRows(); ++row)
+                {
+                    for (unsigned char col = 0; col < board.GetCols(); ++col)
+                    {
+                        // Keep the boards sparse so both outcomes show up.
+                        if (rng() % 3 == 0)
+                            board.SetCharAt(row, col, cell(rng) == 0 ? 'X' : 'O');
+                    }
+                }
+
+                for (char player : {'X', 'O'})
+                {
+                    bool scanned = board.CheckForRecurringCharsInRow(player) || board.CheckForRecurringCharsInCol(player) ||
+                                   board.CheckForRecurringCharsInDiagonal(player) || board.CheckForRecurringCharsInAntiDiagonal(player);
+                    EXPECT_EQ(board.GetBitBoard().HasRun(player, 3), scanned) << board.GetGridInfo();
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
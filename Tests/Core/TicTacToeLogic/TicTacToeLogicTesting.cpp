@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include "Grid/Grid.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <random>
+#include <vector>
 
 #include <durlib.h>
 
@@ -336,6 +339,39 @@ namespace GridWorks
         EXPECT_ANY_THROW(PlayerMove('X', invalidRow, invalidCol));                  // Invalid move attempt
     }
 
+    // Differential test: the last move check must agree with the full scans after every move of random games.
+    TEST(IncrementalTTTLogicTest, LastMoveCheckMatchesFullScan)
+    {
+        // Fixed seed, so a failing game can be replayed.
+        std::mt19937 rng(7);
+
+        for (int game = 0; game < 200; ++game)
+        {
+            unsigned char rows = static_cast<unsigned char>(3 + rng() % 10);
+            unsigned char cols = static_cast<unsigned char>(3 + rng() % 10);
+            Grid grid(rows, cols, '.');
+            grid.SetWinLength(static_cast<unsigned char>(3 + rng() % 3));
+
+            std::vector<std::pair<unsigned char, unsigned char>> cells;
+            for (unsigned char row = 0; row < rows; ++row)
+                for (unsigned char col = 0; col < cols; ++col)
+                    cells.push_back({row, col});
+            std::shuffle(cells.begin(), cells.end(), rng);
+
+            char player = 'X';
+            for (const auto &[row, col] : cells)
+            {
+                grid.SetCharAt(row, col, player);
+
+                bool lastMoveWin = grid.CheckForRecurringCharsAround(row, col);
+                ASSERT_EQ(lastMoveWin, CheckForWin(&grid, player)) << "game " << game << "\n" << grid.GetGridInfo() << fmt::format("{}", grid);
+                if (lastMoveWin)
+                    break;
+
+                player = player == 'X' ? 'O' : 'X';
+            }
+        }
+    }
 };
 
 int main(int argc, char **argv)